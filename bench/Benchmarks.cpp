@@ -0,0 +1,676 @@
+#include "../include/BlastResolver.hpp"
+#include "../include/Bomb.hpp"
+#include "../include/BombPool.hpp"
+#include "../include/ClusterGraph.hpp"
+#include "../include/DangerMap.hpp"
+#include "../include/FlowField.hpp"
+#include "../include/GameState.hpp"
+#include "../include/HierarchicalPathfinder.hpp"
+#include "../include/Map.hpp"
+#include "../include/Random.hpp"
+#include "../include/Simulation.hpp"
+#include "../include/TimerWheel.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @file Benchmarks.cpp
+ * @brief Micro-benchmarks for the core game routines (make bench)
+ * 
+ * Every benchmark runs a number of samples, each timing a batch of
+ * operations, and reports the mean ns/op with its standard deviation
+ * and the fastest sample. Map sizes and entity counts are swept so that
+ * scaling behaviour is visible, not just a single data point.
+ * 
+ * Usage: bomberman_bench [name filter]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int SAMPLES = 15;                 ///< Timed samples per benchmark
+const int MAP_SIZES[][2] = {{21, 15}, {61, 45}, {121, 91}, {241, 181}};
+const int LARGE_MAP_SIZES[][2] = {{1001, 1001}, {2001, 2001}};
+
+volatile std::size_t sink;              ///< Keeps results observable
+
+/**
+ * @struct Stats
+ * @brief Summary of the samples of one benchmark
+ */
+struct Stats {
+    double mean;        ///< Mean ns/op
+    double stddev;      ///< Standard deviation of ns/op between samples
+    double min;         ///< Fastest sample ns/op
+};
+
+/**
+ * @brief Summarize per-sample ns/op values
+ * @param samples ns/op of each sample
+ * @return Statistics
+ */
+Stats summarize(const std::vector<double>& samples) {
+    double sum = 0.0;
+    double min = samples[0];
+    for (double value : samples) {
+        sum += value;
+        min = value < min ? value : min;
+    }
+    double mean = sum / samples.size();
+    
+    double variance = 0.0;
+    for (double value : samples) {
+        variance += (value - mean) * (value - mean);
+    }
+    variance /= samples.size() > 1 ? samples.size() - 1 : 1;
+    
+    return {mean, std::sqrt(variance), min};
+}
+
+/**
+ * @brief Print one result line
+ * @param name Benchmark name
+ * @param params Parameters of this run
+ * @param stats Measured statistics
+ */
+void report(const char* name, const std::string& params, const Stats& stats) {
+    std::printf("%-28s %-22s %12.1f ns/op  +/- %5.1f%%  (min %.1f)\n",
+                name, params.c_str(), stats.mean,
+                stats.mean > 0 ? 100.0 * stats.stddev / stats.mean : 0.0, stats.min);
+}
+
+/**
+ * @brief Time batches of an operation
+ * @param ops Operations per sample
+ * @param setup Untimed preparation before each sample
+ * @param op Operation, called with the operation number
+ * @return Statistics over the samples (one warm-up sample is discarded)
+ */
+template <typename Setup, typename Op>
+Stats measureBatch(int ops, Setup setup, Op op) {
+    std::vector<double> samples;
+    for (int sample = 0; sample <= SAMPLES; sample++) {
+        setup();
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < ops; i++) {
+            op(i);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (sample > 0) {
+            samples.push_back(ns / ops);
+        }
+    }
+    return summarize(samples);
+}
+
+/**
+ * @brief Time an operation that needs untimed preparation every call
+ * @param ops Operations per sample
+ * @param prepare Untimed preparation before each operation
+ * @param op Operation
+ * @return Statistics over the samples (one warm-up sample is discarded)
+ */
+template <typename Prepare, typename Op>
+Stats measureEach(int ops, Prepare prepare, Op op) {
+    std::vector<double> samples;
+    for (int sample = 0; sample <= SAMPLES; sample++) {
+        double ns = 0.0;
+        for (int i = 0; i < ops; i++) {
+            prepare(i);
+            Clock::time_point start = Clock::now();
+            op(i);
+            ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+        if (sample > 0) {
+            samples.push_back(ns / ops);
+        }
+    }
+    return summarize(samples);
+}
+
+/**
+ * @brief Format a map size
+ * @param width Map width
+ * @param height Map height
+ * @return "WxH"
+ */
+std::string sizeLabel(int width, int height) {
+    return std::to_string(width) + "x" + std::to_string(height);
+}
+
+/**
+ * @brief Collect the walkable cells of a map
+ * @param map Map to scan
+ * @return (x, y) pairs of EMPTY cells
+ */
+std::vector<std::pair<int, int>> emptyCells(const Map& map) {
+    std::vector<std::pair<int, int>> cells;
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getCellUnchecked(x, y) == CellType::EMPTY) {
+                cells.push_back({x, y});
+            }
+        }
+    }
+    return cells;
+}
+
+/**
+ * @brief Map::initialize over map sizes
+ */
+void benchMapInitialize() {
+    for (const auto& size : MAP_SIZES) {
+        Map map(size[0], size[1]);
+        Stats stats = measureBatch(200, [] {}, [&](int) {
+            map.initialize();
+        });
+        report("Map::initialize", sizeLabel(size[0], size[1]), stats);
+    }
+}
+
+/**
+ * @brief Map::igniteCell with a given share of cells set on fire
+ */
+void benchIgniteCell() {
+    for (const auto& size : MAP_SIZES) {
+        for (int every : {64, 8}) {
+            Map map(size[0], size[1]);
+            std::vector<std::pair<int, int>> cells = emptyCells(map);
+            std::uint64_t tick = 0;
+            Stats stats = measureEach(200, [&](int) {
+                map.expireExplosions(tick);
+                tick++;
+            }, [&](int) {
+                for (size_t c = 0; c < cells.size(); c += every) {
+                    map.igniteCell(map.getIndex(cells[c].first, cells[c].second), tick);
+                }
+            });
+            report("Map::igniteCell",
+                   sizeLabel(size[0], size[1]) + " 1/" + std::to_string(every) + " lit", stats);
+        }
+    }
+}
+
+/**
+ * @brief Map::expireExplosions with a given share of cells on fire
+ */
+void benchExpireExplosions() {
+    for (const auto& size : MAP_SIZES) {
+        for (int every : {64, 8}) {
+            Map map(size[0], size[1]);
+            std::vector<std::pair<int, int>> cells = emptyCells(map);
+            std::uint64_t tick = 0;
+            Stats stats = measureEach(200, [&](int) {
+                tick++;
+                for (size_t c = 0; c < cells.size(); c += every) {
+                    map.igniteCell(map.getIndex(cells[c].first, cells[c].second), tick);
+                }
+            }, [&](int) {
+                map.expireExplosions(tick);
+            });
+            report("Map::expireExplosions",
+                   sizeLabel(size[0], size[1]) + " 1/" + std::to_string(every) + " lit", stats);
+        }
+    }
+}
+
+/**
+ * @brief Simulation::step (enemy movement, bombs, collisions) over map
+ * sizes and enemy counts
+ */
+void benchSimulationStep() {
+    for (const auto& size : MAP_SIZES) {
+        for (int enemies : {3, 30, 300}) {
+            Simulation* simulation = nullptr;
+            SimulationInput input;
+            Stats stats = measureBatch(300, [&] {
+                delete simulation;
+                simulation = new Simulation(size[0], size[1], 60, enemies);
+            }, [&](int) {
+                simulation->step(input);
+            });
+            sink = simulation->getBombs().size();
+            delete simulation;
+            report("Simulation::step", sizeLabel(size[0], size[1]) + " " +
+                   std::to_string(enemies) + " enemies", stats);
+        }
+    }
+}
+
+/**
+ * @brief Simulation::step with the search enemy AI, with and without a time limit
+ */
+void benchSearchStep() {
+    for (int enemies : {3, 16, 64}) {
+        for (int microseconds : {0, 500}) {
+            SearchBudget budget;
+            budget.microseconds = microseconds;
+            
+            Simulation* simulation = nullptr;
+            SimulationInput input;
+            Stats stats = measureBatch(300, [&] {
+                delete simulation;
+                simulation = new Simulation(61, 45, 60, enemies);
+                simulation->setEnemyAi(EnemyAi::SEARCH, budget);
+            }, [&](int) {
+                simulation->step(input);
+            });
+            sink = static_cast<std::size_t>(simulation->getSearchFallbacks());
+            std::string limit = microseconds > 0 ? std::to_string(microseconds) + " us" : "no limit";
+            report("Simulation::step search", std::to_string(enemies) + " enemies " + limit, stats);
+            delete simulation;
+        }
+    }
+}
+
+/**
+ * @brief Simulation::step on a horde map, over worker thread counts
+ */
+void benchHordeStep() {
+    for (EnemyAi ai : {EnemyAi::STANDARD, EnemyAi::SEARCH}) {
+        for (int threads : {1, 2, 4, 8}) {
+            SearchBudget budget;
+            budget.microseconds = 0;
+            
+            Simulation* simulation = nullptr;
+            SimulationInput input;
+            Stats stats = measureBatch(120, [&] {
+                delete simulation;
+                simulation = new Simulation(241, 181, 60, 1000);
+                simulation->setEnemyAi(ai, budget);
+                simulation->setWorkerThreads(threads);
+            }, [&](int) {
+                simulation->step(input);
+            });
+            sink = simulation->getBombs().size();
+            delete simulation;
+            report(ai == EnemyAi::SEARCH ? "Simulation::step search" : "Simulation::step",
+                   "1000 enemies " + std::to_string(threads) + " threads", stats);
+        }
+    }
+}
+
+/**
+ * @brief Bomb lifecycle: fuse expiry, removal and re-placement with a
+ * steady number of live bombs
+ */
+void benchBombLifecycle() {
+    const int fuse = 180;
+    for (int live : {16, 128, 1024}) {
+        BombPool pool;
+        TimerWheel wheel;
+        std::vector<BombPool::Handle> due;
+        std::uint64_t tick = 0;
+        
+        Stats stats = measureBatch(fuse * 4, [&] {
+            pool.reset(static_cast<size_t>(live) * 2);
+            wheel.reset(fuse + 1, pool.capacity());
+            due.reserve(pool.capacity());
+            tick = 0;
+            for (int i = 0; i < live; i++) {
+                std::uint64_t deadline = 1 + static_cast<std::uint64_t>(i) * fuse / live;
+                BombPool::Handle handle = pool.add(Bomb(i % 64, i / 64, Bomb::OwnerType::ENEMY, deadline));
+                wheel.schedule(handle, deadline);
+            }
+        }, [&](int) {
+            tick++;
+            due.clear();
+            wheel.collectDue(tick, due);
+            for (BombPool::Handle handle : due) {
+                const Bomb& bomb = pool.get(handle);
+                Bomb replacement(bomb.getX(), bomb.getY(), Bomb::OwnerType::ENEMY, tick + fuse);
+                pool.remove(handle);
+                BombPool::Handle added = pool.add(replacement);
+                wheel.schedule(added, tick + fuse);
+            }
+        });
+        report("Bomb fuse/remove/re-add", std::to_string(live) + " live bombs", stats);
+    }
+}
+
+/**
+ * @brief BlastResolver::resolve for a full chain reaction over map sizes
+ */
+void benchBlastChain() {
+    for (const auto& size : MAP_SIZES) {
+        Map map(size[0], size[1]);
+        BombPool pool(static_cast<size_t>(size[0]) * size[1]);
+        std::vector<BombPool::Handle> grid(static_cast<size_t>(map.getStride()) * (size[1] + 2),
+                                           BombPool::INVALID_HANDLE);
+        
+        // A bomb on every other empty cell of the odd rows chains them all
+        for (const std::pair<int, int>& cell : emptyCells(map)) {
+            if (cell.second % 2 == 1 && cell.first % 2 == 1) {
+                BombPool::Handle handle = pool.add(Bomb(cell.first, cell.second, Bomb::OwnerType::ENEMY, 1));
+                grid[map.getIndex(cell.first, cell.second)] = handle;
+            }
+        }
+        
+        BlastResolver resolver;
+        resolver.reset(grid.size(), pool.capacity());
+        BlastResult result;
+        std::vector<BombPool::Handle> triggers = {pool.handleAt(0)};
+        
+        Stats stats = measureBatch(50, [] {}, [&](int) {
+            resolver.resolve(map, pool, grid, triggers, result);
+        });
+        sink = result.detonated.size();
+        report("BlastResolver::resolve", sizeLabel(size[0], size[1]) + " " +
+               std::to_string(pool.size()) + " bombs", stats);
+    }
+}
+
+/**
+ * @brief BlastResolver::resolve for a single bomb over map sizes and
+ * explosion ranges, moving the bomb to another empty cell every call
+ */
+void benchBlastSingle() {
+    for (const auto& size : MAP_SIZES) {
+        for (int range : {2, 8}) {
+            Map map(size[0], size[1]);
+            BombPool pool(1);
+            std::vector<BombPool::Handle> grid(static_cast<size_t>(map.getStride()) * (size[1] + 2),
+                                               BombPool::INVALID_HANDLE);
+            std::vector<std::pair<int, int>> cells = emptyCells(map);
+            
+            BlastResolver resolver;
+            resolver.reset(grid.size(), pool.capacity());
+            BlastResult result;
+            std::vector<BombPool::Handle> triggers = {BombPool::INVALID_HANDLE};
+            
+            Stats stats = measureEach(1000, [&](int i) {
+                if (triggers[0] != BombPool::INVALID_HANDLE) {
+                    const Bomb& old = pool.get(triggers[0]);
+                    grid[map.getIndex(old.getX(), old.getY())] = BombPool::INVALID_HANDLE;
+                    pool.remove(triggers[0]);
+                }
+                const std::pair<int, int>& cell = cells[i % cells.size()];
+                triggers[0] = pool.add(Bomb(cell.first, cell.second, Bomb::OwnerType::ENEMY, 1, range));
+                grid[map.getIndex(cell.first, cell.second)] = triggers[0];
+            }, [&](int) {
+                resolver.resolve(map, pool, grid, triggers, result);
+            });
+            sink = result.cells.size();
+            report("BlastResolver::resolve", sizeLabel(size[0], size[1]) + " 1 bomb range " +
+                   std::to_string(range), stats);
+        }
+    }
+}
+
+/**
+ * @brief DangerMap bomb placement, chain removal and rebuild over map sizes
+ */
+void benchDangerMap() {
+    for (const auto& size : MAP_SIZES) {
+        Map map(size[0], size[1]);
+        BombPool pool(static_cast<size_t>(size[0]) * size[1]);
+        std::vector<BombPool::Handle> grid(static_cast<size_t>(map.getStride()) * (size[1] + 2),
+                                           BombPool::INVALID_HANDLE);
+        
+        // One bomb every few empty cells, with staggered fuses so chains
+        // keep lowering ticks
+        std::vector<std::pair<int, int>> cells = emptyCells(map);
+        for (std::size_t i = 0; i < cells.size(); i += 7) {
+            BombPool::Handle handle = pool.add(Bomb(cells[i].first, cells[i].second,
+                                                    Bomb::OwnerType::ENEMY, 100 + i % 50, 2));
+            grid[map.getIndex(cells[i].first, cells[i].second)] = handle;
+        }
+        std::string params = sizeLabel(size[0], size[1]) + " " + std::to_string(pool.size()) + " bombs";
+        
+        DangerMap danger;
+        danger.reset(grid.size(), map.getStride());
+        
+        Stats stats = measureBatch(20, [] {}, [&](int) {
+            danger.rebuild(map, pool, grid);
+        });
+        report("DangerMap::rebuild", params, stats);
+        
+        // Re-adding the earliest bomb walks only the footprints it lowers
+        stats = measureBatch(1000, [] {}, [&](int) {
+            danger.addBomb(map, pool, grid, pool.handleAt(0));
+        });
+        sink = static_cast<std::size_t>(danger.getDetonationTick(map.getIndex(cells[0].first, cells[0].second)));
+        report("DangerMap::addBomb", params, stats);
+        
+        // Set off the earliest bomb and take its chain out again; every
+        // call starts from the full set of bombs
+        BlastResolver resolver;
+        resolver.reset(grid.size(), pool.capacity());
+        BlastResult blast;
+        resolver.resolve(map, pool, grid, {pool.handleAt(0)}, blast);
+        
+        Map openedMap = map;
+        BombPool remaining = pool;
+        std::vector<BombPool::Handle> remainingGrid = grid;
+        stats = measureEach(200, [&](int) {
+            openedMap = map;
+            remaining = pool;
+            remainingGrid = grid;
+            danger.rebuild(openedMap, remaining, remainingGrid);
+            for (int index : blast.destroyedBlocks) {
+                openedMap.setCellAt(index, CellType::EMPTY);
+            }
+            for (BombPool::Handle handle : blast.detonated) {
+                const Bomb& bomb = remaining.get(handle);
+                remainingGrid[map.getIndex(bomb.getX(), bomb.getY())] = BombPool::INVALID_HANDLE;
+                remaining.remove(handle);
+            }
+        }, [&](int) {
+            danger.removeChain(openedMap, remaining, remainingGrid, blast.cells, blast.destroyedBlocks);
+        });
+        report("DangerMap::removeChain", params + ", chain of " +
+               std::to_string(blast.detonated.size()), stats);
+    }
+}
+
+/**
+ * @brief FlowField full sweep and incremental update over map sizes
+ */
+void benchFlowField() {
+    for (const auto& size : MAP_SIZES) {
+        Map map(size[0], size[1]);
+        std::vector<BombPool::Handle> grid(static_cast<size_t>(map.getStride()) * (size[1] + 2),
+                                           BombPool::INVALID_HANDLE);
+        std::vector<std::pair<int, int>> cells = emptyCells(map);
+        int target = map.getIndex(cells[0].first, cells[0].second);
+        
+        FlowField field;
+        field.reset(grid.size(), map.getStride());
+        field.setTarget(target);
+        
+        Stats stats = measureBatch(20, [] {}, [&](int) {
+            field.invalidate();
+            field.update(map, grid);
+        });
+        report("FlowField sweep", sizeLabel(size[0], size[1]), stats);
+        
+        // Opening a cell far from the target only relaxes what it reaches
+        int far = map.getIndex(cells.back().first, cells.back().second);
+        stats = measureBatch(1000, [] {}, [&](int) {
+            field.openCell(far);
+            field.update(map, grid);
+        });
+        sink = field.getDistance(far);
+        report("FlowField openCell", sizeLabel(size[0], size[1]), stats);
+    }
+}
+
+/**
+ * @brief ClusterGraph build and update, and long HierarchicalPathfinder
+ * queries against a FlowField sweep, on large maps
+ */
+void benchPathfinder() {
+    for (const auto& size : LARGE_MAP_SIZES) {
+        Map map(size[0], size[1]);
+        std::vector<BombPool::Handle> grid(static_cast<size_t>(map.getStride()) * (size[1] + 2),
+                                           BombPool::INVALID_HANDLE);
+        std::vector<std::pair<int, int>> cells = emptyCells(map);
+        std::vector<int> blocks;
+        for (int y = 0; y < size[1]; y++) {
+            for (int x = 0; x < size[0]; x++) {
+                if (map.getCellUnchecked(x, y) == CellType::BLOCK) {
+                    blocks.push_back(map.getIndex(x, y));
+                }
+            }
+        }
+        
+        ClusterGraph graph;
+        Stats stats = measureBatch(1, [] {}, [&](int) {
+            graph.build(map, 16);
+        });
+        report("ClusterGraph::build", sizeLabel(size[0], size[1]), stats);
+        
+        // Every operation destroys a block nobody destroyed before
+        std::size_t nextBlock = 0;
+        stats = measureBatch(100, [] {}, [&](int) {
+            int index = blocks[nextBlock++ % blocks.size()];
+            map.setCellAt(index, CellType::EMPTY);
+            graph.markCellChanged(index);
+            graph.update(map);
+        });
+        report("ClusterGraph::update", sizeLabel(size[0], size[1]), stats);
+        
+        // Random pairs of cells, most of them hundreds of steps apart
+        Random random(1);
+        std::vector<std::pair<int, int>> queries(200);
+        for (auto& query : queries) {
+            const auto& from = cells[random.nextBelow(static_cast<std::uint32_t>(cells.size()))];
+            const auto& to = cells[random.nextBelow(static_cast<std::uint32_t>(cells.size()))];
+            query = {map.getIndex(from.first, from.second), map.getIndex(to.first, to.second)};
+        }
+        HierarchicalPathfinder pathfinder;
+        std::size_t total = 0;
+        stats = measureBatch(static_cast<int>(queries.size()), [] {}, [&](int i) {
+            int direction;
+            total += pathfinder.findPath(graph, map, queries[i].first, queries[i].second, direction);
+        });
+        sink = total;
+        report("HierarchicalPathfinder", sizeLabel(size[0], size[1]), stats);
+        
+        FlowField field;
+        field.reset(grid.size(), map.getStride());
+        field.setTarget(queries[0].second);
+        stats = measureBatch(1, [] {}, [&](int) {
+            field.invalidate();
+            field.update(map, grid);
+        });
+        sink = field.getDistance(queries[0].first);
+        report("FlowField sweep", sizeLabel(size[0], size[1]), stats);
+    }
+}
+
+/**
+ * @brief GameState copies and Simulation save/restore mid-match
+ */
+void benchGameState() {
+    Simulation simulation(21, 15, 60, 3, 7);
+    SimulationInput input;
+    for (int i = 0; i < 600; i++) {
+        input.moveRight = (i / 40) % 2 == 0;
+        input.moveDown = !input.moveRight;
+        input.placeBomb = i % 50 == 0;
+        simulation.step(input);
+    }
+    
+    GameState state;
+    GameState copy;
+    simulation.saveState(state);
+    std::string params = std::to_string(sizeof(GameState)) + " bytes";
+    
+    Stats stats = measureBatch(100000, [] {}, [&](int i) {
+        state.tick += i & 1;
+        state.save(copy);
+    });
+    sink = static_cast<std::size_t>(copy.tick);
+    report("GameState::save", params, stats);
+    
+    stats = measureBatch(10000, [] {}, [&](int) {
+        simulation.saveState(state);
+    });
+    report("Simulation::saveState", "21x15 3 enemies", stats);
+    
+    stats = measureBatch(10000, [] {}, [&](int) {
+        simulation.restoreState(state);
+    });
+    report("Simulation::restoreState", "21x15 3 enemies", stats);
+}
+
+/**
+ * @brief Random numbers below a small bound: std::rand against Random
+ */
+void benchRandom() {
+    const int OPS = 100000;
+    std::size_t total = 0;
+    
+    Stats stats = measureBatch(OPS, [] {}, [&](int) {
+        total += static_cast<std::size_t>(std::rand() % 4);
+    });
+    report("random", "std::rand() % 4", stats);
+    
+    Random random(1);
+    stats = measureBatch(OPS, [] {}, [&](int) {
+        total += random.nextBelow(4);
+    });
+    report("random", "Random::nextBelow", stats);
+    
+    std::vector<int> batch(OPS);
+    stats = measureBatch(1, [] {}, [&](int) {
+        random.fillBelow(batch.data(), batch.size(), 4);
+    });
+    report("random", "Random::fillBelow", {stats.mean / OPS, stats.stddev / OPS, stats.min / OPS});
+    
+    sink = total + static_cast<std::size_t>(batch[0]);
+}
+
+/**
+ * @struct Benchmark
+ * @brief Named benchmark entry
+ */
+struct Benchmark {
+    const char* name;       ///< Name used for filtering
+    void (*run)();          ///< Benchmark function
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"initialize", benchMapInitialize},
+    {"igniteCell", benchIgniteCell},
+    {"expireExplosions", benchExpireExplosions},
+    {"step", benchSimulationStep},
+    {"search", benchSearchStep},
+    {"horde", benchHordeStep},
+    {"bombs", benchBombLifecycle},
+    {"blast", benchBlastChain},
+    {"blast1", benchBlastSingle},
+    {"flow", benchFlowField},
+    {"path", benchPathfinder},
+    {"danger", benchDangerMap},
+    {"state", benchGameState},
+    {"random", benchRandom}
+};
+
+} // namespace
+
+/**
+ * @brief Run every benchmark whose name contains the optional filter
+ * @param argc Argument count
+ * @param argv Arguments (argv[1]: name filter)
+ * @return Exit code (0 for success)
+ */
+int main(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    
+    std::printf("%-28s %-22s %12s\n", "benchmark", "parameters", "mean");
+    for (const Benchmark& benchmark : BENCHMARKS) {
+        if (std::strstr(benchmark.name, filter)) {
+            benchmark.run();
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,134 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Bitboard
+ * @brief Fixed-size set of bits, one per map cell, stored in 64-bit words
+ * 
+ * Bit i corresponds to index i of the padded Map cell buffer. Clearing
+ * and scanning for set bits work a word at a time.
+ */
+class Bitboard {
+public:
+    /**
+     * @brief Constructor for Bitboard
+     * @param bitCount Number of bits (all cleared)
+     */
+    explicit Bitboard(std::size_t bitCount = 0);
+    
+    /**
+     * @brief Destructor
+     */
+    ~Bitboard();
+    
+    /**
+     * @brief Change the number of bits and clear them all
+     * @param bitCount Number of bits
+     */
+    void resize(std::size_t bitCount);
+    
+    /**
+     * @brief Get the number of bits
+     * @return Bit count
+     */
+    std::size_t size() const;
+    
+    /**
+     * @brief Get the number of 64-bit words
+     * @return Word count
+     */
+    std::size_t wordCount() const;
+    
+    /**
+     * @brief Access the underlying words
+     * @return Pointer to the first word
+     */
+    const std::uint64_t* data() const;
+    
+    /**
+     * @brief Access the underlying words
+     * @return Pointer to the first word
+     */
+    std::uint64_t* data();
+    
+    /**
+     * @brief Test a bit
+     * @param index Bit index
+     * @return True if the bit is set
+     */
+    bool test(std::size_t index) const;
+    
+    /**
+     * @brief Set a bit
+     * @param index Bit index
+     */
+    void set(std::size_t index);
+    
+    /**
+     * @brief Clear a bit
+     * @param index Bit index
+     */
+    void reset(std::size_t index);
+    
+    /**
+     * @brief Clear all bits
+     */
+    void clear();
+    
+    /**
+     * @brief Call a function for every set bit, in increasing order
+     * @param fn Callable taking the bit index
+     */
+    template <typename Fn>
+    void forEachSetBit(Fn fn) const;
+
+private:
+    std::size_t bitCount;               ///< Number of valid bits
+    std::vector<std::uint64_t> words;   ///< Bit storage
+};
+
+/**
+ * @brief Test a bit
+ * @param index Bit index
+ * @return True if the bit is set
+ */
+inline bool Bitboard::test(std::size_t index) const {
+    return (words[index >> 6] >> (index & 63)) & 1u;
+}
+
+/**
+ * @brief Set a bit
+ * @param index Bit index
+ */
+inline void Bitboard::set(std::size_t index) {
+    words[index >> 6] |= std::uint64_t(1) << (index & 63);
+}
+
+/**
+ * @brief Clear a bit
+ * @param index Bit index
+ */
+inline void Bitboard::reset(std::size_t index) {
+    words[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+}
+
+/**
+ * @brief Call a function for every set bit, in increasing order
+ * @param fn Callable taking the bit index
+ */
+template <typename Fn>
+void Bitboard::forEachSetBit(Fn fn) const {
+    for (std::size_t w = 0; w < words.size(); w++) {
+        std::uint64_t bits = words[w];
+        while (bits) {
+            fn((w << 6) + static_cast<std::size_t>(__builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+#endif // BITBOARD_HPP
@@ -0,0 +1,91 @@
+#ifndef BLAST_RESOLVER_HPP
+#define BLAST_RESOLVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BombPool.hpp"
+#include "Map.hpp"
+
+/**
+ * @struct BlastResult
+ * @brief Everything affected by one chain of explosions
+ */
+struct BlastResult {
+    std::vector<int> cells;                     ///< Padded indices set on fire (each once, blocks excluded)
+    std::vector<int> destroyedBlocks;           ///< Padded indices of blocks destroyed (each once)
+    std::vector<BombPool::Handle> detonated;    ///< Every bomb that went off, triggers first
+};
+
+/**
+ * @class BlastResolver
+ * @brief Resolves bomb explosions, including chain reactions, in one pass
+ * 
+ * Each detonating bomb's cross-shaped footprint is walked exactly once.
+ * The walk records burning cells and destroyed blocks, and queues any
+ * other bomb it reaches so it detonates in the same tick. Cells and bombs
+ * are de-duplicated with generation stamps, so a whole cascade costs
+ * time linear in the cells its footprints cover.
+ * 
+ * Blocks are only reported, not removed, while the cascade runs: every
+ * bomb in the chain sees the map as it was when the chain started, and
+ * rays stop at the first block they reach. Bombs do not stop rays.
+ */
+class BlastResolver {
+public:
+    /**
+     * @brief Constructor for BlastResolver
+     */
+    BlastResolver();
+    
+    /**
+     * @brief Destructor
+     */
+    ~BlastResolver();
+    
+    /**
+     * @brief Size the internal buffers (done once per map)
+     * @param cellCount Number of cells in the padded map buffer
+     * @param bombCapacity Capacity of the bomb pool
+     */
+    void reset(std::size_t cellCount, std::size_t bombCapacity);
+    
+    /**
+     * @brief Resolve a chain of explosions
+     * @param map Game map (read only)
+     * @param bombs Active bombs (read only)
+     * @param bombGrid Bomb handle per padded map index
+     * @param triggers Bombs whose fuse ran out this tick
+     * @param result Output, cleared first
+     */
+    void resolve(const Map& map,
+                 const BombPool& bombs,
+                 const std::vector<BombPool::Handle>& bombGrid,
+                 const std::vector<BombPool::Handle>& triggers,
+                 BlastResult& result);
+
+private:
+    /**
+     * @brief Record a cell reached by fire
+     * @param index Padded map index
+     * @param cell Cell type at that index
+     * @param bombGrid Bomb handle per padded map index
+     * @param result Result being built
+     */
+    void burn(int index, CellType cell,
+              const std::vector<BombPool::Handle>& bombGrid,
+              BlastResult& result);
+    
+    /**
+     * @brief Queue a bomb for detonation unless it already is
+     * @param handle Bomb handle
+     * @param result Result being built
+     */
+    void enqueue(BombPool::Handle handle, BlastResult& result);
+
+    std::vector<std::uint32_t> cellStamps;  ///< Generation in which each cell was recorded
+    std::vector<std::uint32_t> bombStamps;  ///< Generation in which each bomb was queued
+    std::uint32_t generation;               ///< Current resolve() call
+};
+
+#endif // BLAST_RESOLVER_HPP
@@ -1,14 +1,17 @@
 #ifndef BOMB_HPP
 #define BOMB_HPP
 
-#include <SFML/System.hpp>
+#include <cstdint>
 
 /**
  * @class Bomb
  * @brief Represents a bomb in the Bomberman game
  * 
  * This class handles bomb timing, explosion, and position.
- * Bombs explode after a certain time and create explosions.
+ * Bombs explode on a fixed simulation tick and create explosions; the
+ * Simulation schedules that tick on its fuse timer wheel.
+ * It is a plain, trivially copyable record (no destructor) so bombs can be
+ * stored by value and moved around freely by BombPool.
  */
 class Bomb {
 public:
@@ -25,15 +28,12 @@ public:
      * @param x X position of the bomb on the map
      * @param y Y position of the bomb on the map
      * @param owner Type of owner (player or enemy)
-     * @param fuseTime Time in seconds before explosion
+     * @param detonationTick Simulation tick on which the bomb explodes
      * @param explosionRange Range of the explosion
+     * @param ownerIndex Index of the owning enemy (ignored for the player)
      */
-    Bomb(int x, int y, OwnerType owner = OwnerType::PLAYER, float fuseTime = 3.0f, int explosionRange = 2);
-    
-    /**
-     * @brief Destructor
-     */
-    ~Bomb();
+    Bomb(int x, int y, OwnerType owner, std::uint64_t detonationTick, int explosionRange = 2,
+         int ownerIndex = 0);
     
     /**
      * @brief Get the X position of the bomb
@@ -48,11 +48,9 @@ public:
     int getY() const;
     
     /**
-     * @brief Update the bomb state
-     * @param deltaTime Time elapsed since last update
-     * @return True if bomb has exploded, false otherwise
+     * @brief Mark the bomb as exploded
      */
-    bool update(float deltaTime);
+    void explode();
     
     /**
      * @brief Check if the bomb has exploded
@@ -66,24 +64,37 @@ public:
      */
     int getExplosionRange() const;
     
+    /**
+     * @brief Get the tick on which the bomb explodes
+     * @return Detonation tick
+     */
+    std::uint64_t getDetonationTick() const;
+    
     /**
      * @brief Get remaining fuse time
-     * @return Remaining time before explosion
+     * @param currentTick Current simulation tick
+     * @return Remaining ticks before explosion (0 once due)
      */
-    float getRemainingTime() const;
+    int getRemainingTicks(std::uint64_t currentTick) const;
     
     /**
      * @brief Get the owner type of the bomb
      * @return OwnerType (PLAYER or ENEMY)
      */
     OwnerType getOwner() const;
+    
+    /**
+     * @brief Get the index of the enemy that placed the bomb
+     * @return Index into Simulation::getEnemies() (0 for player bombs)
+     */
+    int getOwnerIndex() const;
 
 private:
     int x;                  ///< X coordinate on the map
     int y;                  ///< Y coordinate on the map
     OwnerType owner;        ///< Owner of the bomb (player or enemy)
-    float fuseTime;         ///< Time before explosion
-    float elapsedTime;      ///< Time elapsed since bomb was placed
+    int ownerIndex;         ///< Index of the owning enemy
+    std::uint64_t detonationTick; ///< Tick on which the bomb explodes
     bool exploded;          ///< Whether the bomb has exploded
     int explosionRange;     ///< Range of the explosion
 };
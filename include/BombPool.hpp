@@ -0,0 +1,136 @@
+#ifndef BOMB_POOL_HPP
+#define BOMB_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Bomb.hpp"
+
+/**
+ * @class BombPool
+ * @brief Fixed-capacity storage for active bombs
+ * 
+ * Bombs are stored by value in one contiguous array that only ever holds
+ * live bombs, so iterating them touches no dead slots. Removing a bomb
+ * moves the last one into its place (swap-and-pop). Callers refer to a
+ * bomb through a stable handle that survives those moves; handles of
+ * removed bombs go on a free list and are reused.
+ * 
+ * All memory is reserved up front, so adding and removing bombs never
+ * allocates.
+ */
+class BombPool {
+public:
+    /**
+     * @brief Stable reference to a bomb in the pool
+     */
+    using Handle = std::uint32_t;
+    
+    static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;  ///< No bomb
+    
+    /**
+     * @brief Constructor for BombPool
+     * @param capacity Maximum number of simultaneous bombs
+     */
+    explicit BombPool(std::size_t capacity = 0);
+    
+    /**
+     * @brief Destructor
+     */
+    ~BombPool();
+    
+    /**
+     * @brief Drop all bombs and change the capacity
+     * @param capacity Maximum number of simultaneous bombs
+     */
+    void reset(std::size_t capacity);
+    
+    /**
+     * @brief Get the maximum number of simultaneous bombs
+     * @return Capacity
+     */
+    std::size_t capacity() const;
+    
+    /**
+     * @brief Get the number of active bombs
+     * @return Active bomb count
+     */
+    std::size_t size() const;
+    
+    /**
+     * @brief Check if there are no active bombs
+     * @return True if the pool is empty
+     */
+    bool empty() const;
+    
+    /**
+     * @brief Add a bomb
+     * @param bomb Bomb to copy into the pool
+     * @return Handle of the new bomb, or INVALID_HANDLE if the pool is full
+     */
+    Handle add(const Bomb& bomb);
+    
+    /**
+     * @brief Remove a bomb (the last bomb moves into its slot)
+     * @param handle Handle of the bomb to remove
+     */
+    void remove(Handle handle);
+    
+    /**
+     * @brief Access a bomb by handle
+     * @param handle Handle of an active bomb
+     * @return Bomb reference (valid until the next add/remove)
+     */
+    Bomb& get(Handle handle);
+    
+    /**
+     * @brief Access a bomb by handle
+     * @param handle Handle of an active bomb
+     * @return Bomb reference (valid until the next add/remove)
+     */
+    const Bomb& get(Handle handle) const;
+    
+    /**
+     * @brief Get the handle of the bomb at a position in the dense array
+     * @param index Position in [0, size())
+     * @return Handle of that bomb
+     */
+    Handle handleAt(std::size_t index) const;
+    
+    /**
+     * @brief Remove every bomb
+     */
+    void clear();
+    
+    /**
+     * @brief Iterate the active bombs
+     * @return Pointer to the first active bomb
+     */
+    Bomb* begin();
+    
+    /**
+     * @brief Iterate the active bombs
+     * @return Pointer past the last active bomb
+     */
+    Bomb* end();
+    
+    /**
+     * @brief Iterate the active bombs
+     * @return Pointer to the first active bomb
+     */
+    const Bomb* begin() const;
+    
+    /**
+     * @brief Iterate the active bombs
+     * @return Pointer past the last active bomb
+     */
+    const Bomb* end() const;
+
+private:
+    std::vector<Bomb> bombs;                ///< Active bombs, densely packed
+    std::vector<Handle> handles;            ///< Handle of each dense slot
+    std::vector<std::uint32_t> slots;       ///< Dense slot of each handle
+    std::vector<Handle> freeHandles;        ///< Handles available for reuse
+};
+
+#endif // BOMB_POOL_HPP
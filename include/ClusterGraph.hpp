@@ -0,0 +1,305 @@
+#ifndef CLUSTER_GRAPH_HPP
+#define CLUSTER_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Map.hpp"
+
+/**
+ * @struct ClusterNode
+ * @brief One side of an entrance between two neighbouring clusters
+ */
+struct ClusterNode {
+    int cell;       ///< Padded map index
+    int cluster;    ///< Cluster the cell belongs to
+    int slot;       ///< Position in the cluster's node list
+    int peer;       ///< Node on the other side of the entrance
+};
+
+/**
+ * @class ClusterGraph
+ * @brief Abstract graph of a Map for hierarchical pathfinding (HPA*)
+ *
+ * The map is cut into square clusters. Where two neighbouring clusters
+ * share a stretch of walkable border, one or two entrances connect
+ * them; each entrance is a pair of nodes, one on each side, one step
+ * apart. Inside every cluster the walking distance between each pair
+ * of its nodes is precomputed with a search confined to the cluster, so
+ * a long path is a walk over a few nodes per cluster instead of every
+ * cell on the way (see HierarchicalPathfinder).
+ *
+ * The walkable cells are also kept in connected sets (union-find): a
+ * cell that opens joins the sets around it, so whether two cells are
+ * connected at all is answered without a search. Only a cell closing
+ * makes the sets be worked out again from scratch.
+ *
+ * Walls and blocks are obstacles; bombs and fire are not, since they
+ * are gone long before a path across the map is walked. Cells whose
+ * walkability changes (a block destroyed) are reported with
+ * markCellChanged(), and update() then rebuilds only the clusters they
+ * are in, plus the entrances of a border the cell lies on and the
+ * cluster across it.
+ */
+class ClusterGraph {
+public:
+    static constexpr std::uint16_t NO_PATH = 0xFFFF;    ///< Cost between nodes with no path
+    static constexpr int MIN_CLUSTER_SIZE = 4;          ///< Smallest cluster side
+    static constexpr int MAX_CLUSTER_SIZE = 64;         ///< Largest cluster side
+    
+    /**
+     * @brief Constructor for ClusterGraph (empty until built)
+     */
+    ClusterGraph();
+    
+    /**
+     * @brief Build the whole graph for a map
+     * @param map Map to cover
+     * @param clusterSize Cluster side in cells (clamped to the limits above)
+     */
+    void build(const Map& map, int clusterSize);
+    
+    /**
+     * @brief Report a cell that became walkable or blocked
+     * @param index Padded map index
+     */
+    void markCellChanged(int index);
+    
+    /**
+     * @brief Rebuild the parts of the graph touched by reported cells
+     * @param map Map the graph covers
+     */
+    void update(const Map& map);
+    
+    /**
+     * @brief Check whether the graph has been built
+     * @return True after build()
+     */
+    bool isBuilt() const;
+    
+    /**
+     * @brief Check whether any path joins two cells
+     * @param from Padded map index
+     * @param to Padded map index
+     * @return True if both cells are walkable and connected
+     */
+    bool isConnected(int from, int to) const;
+    
+    /**
+     * @brief Get the cluster side
+     * @return Cells per cluster side
+     */
+    int getClusterSize() const;
+    
+    /**
+     * @brief Get the cluster a cell belongs to
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return Cluster number
+     */
+    int getClusterOf(int x, int y) const;
+    
+    /**
+     * @brief Get the cells a cluster covers
+     * @param cluster Cluster number
+     * @param x0 Output, first column
+     * @param y0 Output, first row
+     * @param x1 Output, column past the last one
+     * @param y1 Output, row past the last one
+     */
+    void getClusterBounds(int cluster, int& x0, int& y0, int& x1, int& y1) const;
+    
+    /**
+     * @brief Get the nodes inside a cluster
+     * @param cluster Cluster number
+     * @return Node ids in slot order
+     */
+    const std::vector<int>& getClusterNodes(int cluster) const;
+    
+    /**
+     * @brief Get the walking distance between two nodes of a cluster
+     * @param cluster Cluster number
+     * @param fromSlot Slot of the first node
+     * @param toSlot Slot of the second node
+     * @return Steps inside the cluster, or NO_PATH
+     */
+    std::uint16_t getCost(int cluster, int fromSlot, int toSlot) const;
+    
+    /**
+     * @brief Get a node
+     * @param id Node id
+     * @return Node
+     */
+    const ClusterNode& getNode(int id) const;
+    
+    /**
+     * @brief Get the number of node ids in use or free
+     * @return Size a per-node array needs
+     */
+    std::size_t getNodeCapacity() const;
+    
+    /**
+     * @brief Get the number of nodes in the graph
+     * @return Node count
+     */
+    std::size_t getNodeCount() const;
+    
+    /**
+     * @brief Get the number of cluster rebuilds done so far
+     * @return Rebuild count, the initial build included
+     */
+    std::uint64_t getRebuildCount() const;
+
+private:
+    static const int SPLIT_ENTRANCE_LENGTH = 6; ///< Shared stretches this long get an entrance at each end
+    static constexpr int NO_SET = -1;           ///< Set of walls and blocks
+    
+    /**
+     * @struct Cluster
+     * @brief Nodes of one cluster and the distances between them
+     */
+    struct Cluster {
+        std::vector<int> nodes;             ///< Node ids in slot order
+        std::vector<std::uint16_t> costs;   ///< nodes.size() squared distances, row per slot
+        bool dirty = false;                 ///< Whether update() has to rebuild it
+    };
+    
+    /**
+     * @brief Check whether a path can go through a cell
+     * @param map Map the graph covers
+     * @param index Padded map index
+     * @return True unless the cell is a wall or a block
+     */
+    static bool isOpen(const Map& map, int index);
+    
+    /**
+     * @brief Queue a border for rebuilding
+     * @param border Border number
+     */
+    void markBorder(int border);
+    
+    /**
+     * @brief Queue a cluster for rebuilding
+     * @param cluster Cluster number
+     */
+    void markCluster(int cluster);
+    
+    /**
+     * @brief Place the entrances of a border between two clusters
+     * @param map Map the graph covers
+     * @param border Border number
+     */
+    void rebuildBorder(const Map& map, int border);
+    
+    /**
+     * @brief Collect a cluster's nodes and recompute their distances
+     * @param map Map the graph covers
+     * @param cluster Cluster number
+     */
+    void rebuildCluster(const Map& map, int cluster);
+    
+    /**
+     * @brief Put every walkable cell into its connected set
+     * @param map Map the graph covers
+     */
+    void connectAll(const Map& map);
+    
+    /**
+     * @brief Join a newly opened cell with its walkable neighbours
+     * @param map Map the graph covers
+     * @param index Padded map index
+     */
+    void connectCell(const Map& map, int index);
+    
+    /**
+     * @brief Merge the sets of two cells
+     * @param a Padded map index
+     * @param b Padded map index
+     */
+    void joinSets(int a, int b);
+    
+    /**
+     * @brief Get the set of a cell
+     * @param index Padded map index of a walkable cell
+     * @return Padded index of the set's root cell
+     */
+    int findSet(int index) const;
+    
+    /**
+     * @brief Add an entrance: a node on each side of a border
+     * @param border Border number
+     * @param cellA Padded index on the first cluster's side
+     * @param clusterA First cluster
+     * @param cellB Padded index on the second cluster's side
+     * @param clusterB Second cluster
+     */
+    void addEntrance(int border, int cellA, int clusterA, int cellB, int clusterB);
+    
+    /**
+     * @brief Get a free node id
+     * @return Node id
+     */
+    int allocateNode();
+    
+    int width;                              ///< Map width in cells
+    int height;                             ///< Map height in cells
+    int stride;                             ///< Padded row length of the map
+    int clusterSize;                        ///< Cluster side in cells
+    int clustersX;                          ///< Clusters per row
+    int clustersY;                          ///< Clusters per column
+    std::vector<Cluster> clusters;          ///< Clusters, row by row
+    std::vector<ClusterNode> nodes;         ///< Nodes by id
+    std::vector<int> freeNodes;             ///< Ids of removed nodes
+    std::vector<std::vector<int>> borderNodes; ///< Node ids on each border (vertical borders, then horizontal)
+    std::vector<bool> borderDirty;          ///< Whether update() has to rebuild each border
+    std::vector<int> dirtyBorders;          ///< Borders to rebuild
+    std::vector<int> dirtyClusters;         ///< Clusters to rebuild
+    std::vector<std::uint16_t> distances;   ///< Scratch distances over one cluster
+    std::vector<int> queue;                 ///< Scratch BFS queue
+    std::vector<int> setParents;            ///< Union-find parent per padded index (NO_SET if closed)
+    std::vector<std::uint8_t> setRanks;     ///< Union-find rank per root
+    std::vector<int> changedCells;          ///< Cells reported since the last update
+    std::uint64_t rebuildCount;             ///< Cluster rebuilds done
+};
+
+/**
+ * @brief Get the cluster a cell belongs to
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return Cluster number
+ */
+inline int ClusterGraph::getClusterOf(int x, int y) const {
+    return (y / clusterSize) * clustersX + x / clusterSize;
+}
+
+/**
+ * @brief Get the nodes inside a cluster
+ * @param cluster Cluster number
+ * @return Node ids in slot order
+ */
+inline const std::vector<int>& ClusterGraph::getClusterNodes(int cluster) const {
+    return clusters[cluster].nodes;
+}
+
+/**
+ * @brief Get the walking distance between two nodes of a cluster
+ * @param cluster Cluster number
+ * @param fromSlot Slot of the first node
+ * @param toSlot Slot of the second node
+ * @return Steps inside the cluster, or NO_PATH
+ */
+inline std::uint16_t ClusterGraph::getCost(int cluster, int fromSlot, int toSlot) const {
+    const Cluster& entry = clusters[cluster];
+    return entry.costs[static_cast<std::size_t>(fromSlot) * entry.nodes.size() + toSlot];
+}
+
+/**
+ * @brief Get a node
+ * @param id Node id
+ * @return Node
+ */
+inline const ClusterNode& ClusterGraph::getNode(int id) const {
+    return nodes[id];
+}
+
+#endif // CLUSTER_GRAPH_HPP
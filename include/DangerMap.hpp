@@ -0,0 +1,156 @@
+#ifndef DANGER_MAP_HPP
+#define DANGER_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BombPool.hpp"
+#include "Map.hpp"
+
+/**
+ * @class DangerMap
+ * @brief Earliest tick at which fire reaches each cell
+ *
+ * Every cell inside the cross-shaped footprint of an active bomb holds
+ * the tick that bomb goes off, and cells covered by several bombs hold
+ * the earliest one. Chains are accounted for: a bomb inside another
+ * bomb's footprint goes off no later than that bomb, so its own
+ * footprint gets the earlier tick too. Rays follow the same rules as
+ * BlastResolver (walls stop them, blocks stop them after burning, bombs
+ * do not), so the map predicts exactly what the fuses will do.
+ *
+ * Placing a bomb only walks the footprints whose tick it lowers. When a
+ * chain goes off, no remaining bomb was inside its footprints (it would
+ * have gone off too), so only the cells the chain burned lose their
+ * tick; the bombs whose footprints cover those cells, or whose rays
+ * stopped at a block the chain destroyed, are stamped again. Nothing
+ * else is touched. Reading a cell is a single array lookup, cheap
+ * enough for every enemy to check every neighbour every tick.
+ */
+class DangerMap {
+public:
+    static constexpr std::uint64_t NEVER = 0xFFFFFFFFFFFFFFFFull;  ///< Tick of cells no bomb reaches
+    
+    /**
+     * @brief Constructor for DangerMap
+     */
+    DangerMap();
+    
+    /**
+     * @brief Size the map and clear every cell
+     * @param cellCount Number of cells in the padded map buffer
+     * @param stride Padded row length of the map
+     */
+    void reset(std::size_t cellCount, int stride);
+    
+    /**
+     * @brief Add the footprint of a newly placed bomb
+     * @param map Game map (read only)
+     * @param bombs Active bombs, the new one included
+     * @param bombGrid Bomb handle per padded map index
+     * @param handle The new bomb
+     */
+    void addBomb(const Map& map, const BombPool& bombs,
+                 const std::vector<BombPool::Handle>& bombGrid,
+                 BombPool::Handle handle);
+    
+    /**
+     * @brief Take out the footprints of a chain of bombs that went off
+     * 
+     * Call it once the detonated bombs have left the pool and the grid
+     * and the destroyed blocks have been cleared from the map.
+     * 
+     * @param map Game map (read only), destroyed blocks already cleared
+     * @param bombs Active bombs, detonated ones already removed
+     * @param bombGrid Bomb handle per padded map index
+     * @param burnedCells Cells the chain set on fire (BlastResult::cells)
+     * @param openedCells Blocks the chain destroyed (BlastResult::destroyedBlocks)
+     */
+    void removeChain(const Map& map, const BombPool& bombs,
+                     const std::vector<BombPool::Handle>& bombGrid,
+                     const std::vector<int>& burnedCells,
+                     const std::vector<int>& openedCells);
+    
+    /**
+     * @brief Restamp every active bomb from scratch (e.g. after a state restore)
+     * @param map Game map (read only)
+     * @param bombs Active bombs
+     * @param bombGrid Bomb handle per padded map index
+     */
+    void rebuild(const Map& map, const BombPool& bombs,
+                 const std::vector<BombPool::Handle>& bombGrid);
+    
+    /**
+     * @brief Get the earliest tick fire reaches a cell
+     * @param index Padded map index
+     * @return Detonation tick, or NEVER
+     */
+    std::uint64_t getDetonationTick(int index) const;
+    
+    /**
+     * @brief Check that no fire reaches a cell up to a given tick
+     * @param index Padded map index
+     * @param untilTick Last tick that has to be safe
+     * @return True if the cell's detonation tick is later than untilTick
+     */
+    bool isSafeUntil(int index, std::uint64_t untilTick) const;
+
+private:
+    /**
+     * @brief Lower a cell's tick, remembering newly stamped cells
+     * @param index Padded map index
+     * @param detonationTick Tick fire gets there
+     * @return True if the tick was lowered
+     */
+    bool lower(int index, std::uint64_t detonationTick);
+    
+    /**
+     * @brief Queue the bombs whose footprint covers a cell
+     * @param map Game map (read only)
+     * @param bombs Active bombs
+     * @param bombGrid Bomb handle per padded map index
+     * @param index Padded map index of a cell that is not a wall
+     */
+    void queueBombsReaching(const Map& map, const BombPool& bombs,
+                            const std::vector<BombPool::Handle>& bombGrid,
+                            int index);
+    
+    /**
+     * @brief Stamp the footprints of the queued bomb cells, following chains
+     * @param map Game map (read only)
+     * @param bombs Active bombs
+     * @param bombGrid Bomb handle per padded map index
+     */
+    void propagate(const Map& map, const BombPool& bombs,
+                   const std::vector<BombPool::Handle>& bombGrid);
+    
+    std::vector<std::uint64_t> ticks;   ///< Earliest detonation tick per padded index
+    std::vector<int> stamped;           ///< Cells stamped since the last rebuild (each once)
+    std::vector<std::uint8_t> stampedFlags; ///< Whether each cell is in stamped
+    std::vector<int> queue;             ///< Bomb cells whose footprint needs stamping
+    std::vector<std::uint32_t> queuedStamps; ///< Generation in which each bomb cell was queued by removeChain
+    std::uint32_t generation;           ///< Current removeChain() call
+    int maxRange;                       ///< Longest explosion range seen since reset
+    int offsets[4];                     ///< Index steps to the four neighbours
+};
+
+/**
+ * @brief Get the earliest tick fire reaches a cell
+ * @param index Padded map index
+ * @return Detonation tick, or NEVER
+ */
+inline std::uint64_t DangerMap::getDetonationTick(int index) const {
+    return ticks[index];
+}
+
+/**
+ * @brief Check that no fire reaches a cell up to a given tick
+ * @param index Padded map index
+ * @param untilTick Last tick that has to be safe
+ * @return True if the cell's detonation tick is later than untilTick
+ */
+inline bool DangerMap::isSafeUntil(int index, std::uint64_t untilTick) const {
+    return ticks[index] > untilTick;
+}
+
+#endif // DANGER_MAP_HPP
@@ -1,6 +1,10 @@
 #ifndef ENEMY_HPP
 #define ENEMY_HPP
 
+#include "Random.hpp"
+
+struct EnemyState;
+
 /**
  * @class Enemy
  * @brief Represents an enemy character in the Bomberman game
@@ -14,8 +18,10 @@ public:
      * @brief Constructor for Enemy
      * @param startX Initial X position on the map
      * @param startY Initial Y position on the map
+     * @param moveDelayTicks Ticks between movements
+     * @param bombDelayTicks Ticks between bomb placements
      */
-    Enemy(int startX, int startY);
+    Enemy(int startX, int startY, int moveDelayTicks, int bombDelayTicks);
     
     /**
      * @brief Destructor
@@ -34,6 +40,23 @@ public:
      */
     int getY() const;
     
+    /**
+     * @brief Get the X position at the start of the current tick
+     * @return Previous X coordinate
+     */
+    int getPreviousX() const;
+    
+    /**
+     * @brief Get the Y position at the start of the current tick
+     * @return Previous Y coordinate
+     */
+    int getPreviousY() const;
+    
+    /**
+     * @brief Remember the current position as the previous one (start of a tick)
+     */
+    void storePreviousPosition();
+    
     /**
      * @brief Move the enemy up
      */
@@ -83,30 +106,56 @@ public:
      */
     bool canPlaceBomb() const;
     
+    /**
+     * @brief Get maximum bomb capacity
+     * @return Maximum number of bombs
+     */
+    int getMaxBombs() const;
+    
+    /**
+     * @brief Get the ticks left before the bomb timer allows another bomb
+     * @return Ticks, 0 if a bomb may be placed now
+     */
+    int getTicksUntilBombReady() const;
+    
+    /**
+     * @brief Copy the enemy into a packed state
+     * @param state Output state
+     */
+    void saveState(EnemyState& state) const;
+    
+    /**
+     * @brief Overwrite the enemy with a packed state
+     * @param state Saved state
+     */
+    void restoreState(const EnemyState& state);
+    
     /**
      * @brief Decrease bomb count when placing a bomb
      */
     void placeBomb();
     
     /**
-     * @brief Update enemy AI behavior
-     * @param deltaTime Time elapsed since last update
+     * @brief Advance enemy AI behavior by one tick
+     * @param random Enemy AI random stream of the match
      * @return True if enemy wants to place a bomb, false otherwise
      */
-    bool update(float deltaTime);
+    bool update(Random& random);
 
 private:
     int x;              ///< X coordinate on the map
     int y;              ///< Y coordinate on the map
+    int prevX;          ///< X coordinate at the start of the tick
+    int prevY;          ///< Y coordinate at the start of the tick
     bool alive;         ///< Enemy's alive status
     int bombCount;      ///< Number of bombs enemy can place
     int maxBombs;       ///< Maximum number of bombs enemy can have
     
-    float moveTimer;    ///< Timer for movement delay
-    float bombTimer;    ///< Timer for bomb placement
+    int moveTimer;      ///< Ticks since last movement decision
+    int bombTimer;      ///< Ticks since last bomb placement
     int lastDirection;  ///< Last movement direction (0=up, 1=down, 2=left, 3=right)
-    const float moveDelay = 0.3f;      ///< Delay between movements in seconds
-    const float bombDelay = 2.0f;      ///< Delay between bomb placements in seconds
+    int moveDelay;      ///< Delay between movements in ticks
+    int bombDelay;      ///< Delay between bomb placements in ticks
 };
 
 #endif // ENEMY_HPP
@@ -0,0 +1,182 @@
+#ifndef ENEMY_SEARCH_HPP
+#define ENEMY_SEARCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "BombPool.hpp"
+#include "DangerMap.hpp"
+#include "FlowField.hpp"
+#include "Map.hpp"
+
+/**
+ * @struct EnemyAction
+ * @brief One enemy decision: where to step and whether to drop a bomb
+ */
+struct EnemyAction {
+    int direction = -1;         ///< 0=up, 1=down, 2=left, 3=right, -1 to stay
+    bool placeBomb = false;     ///< Drop a bomb on the cell left behind
+};
+
+/**
+ * @struct SearchProblem
+ * @brief Everything one enemy looks at when it decides
+ *
+ * The views point into the Simulation and must stay unchanged while
+ * EnemySearch::decide() runs.
+ */
+struct SearchProblem {
+    const Map* map = nullptr;                               ///< Game map
+    const std::vector<BombPool::Handle>* bombGrid = nullptr; ///< Bomb per padded map index
+    const DangerMap* danger = nullptr;                      ///< Earliest fire per cell
+    const FlowField* flow = nullptr;                        ///< Distance to the player
+    std::uint64_t tick = 0;         ///< Tick of the decision
+    int enemyCell = 0;              ///< Padded index of the enemy
+    int playerCell = 0;             ///< Padded index of the player
+    int bombsLeft = 0;              ///< Bombs the enemy has in hand
+    int ticksUntilBombReady = 0;    ///< Ticks before the enemy may drop a bomb
+    int moveDelay = 1;              ///< Ticks between enemy moves
+    int bombDelay = 1;              ///< Ticks between enemy bombs
+    int bombFuse = 1;               ///< Ticks before a bomb goes off
+    int bombRange = 1;              ///< Range of the enemy's bombs
+    int explosionDuration = 1;      ///< Ticks a cell keeps burning
+};
+
+/**
+ * @class EnemySearch
+ * @brief Beam search over one enemy's moves and bombs
+ *
+ * Plans are played out on a small forward model instead of the full
+ * Simulation: the enemy walks one cell per move, the bombs already on
+ * the map go off when the DangerMap says, and the enemy's own planned
+ * bombs add their footprints on top. The player is assumed to stay put.
+ * Every level of the search expands the surviving plans by each step
+ * (four directions or staying, with or without a bomb), scores them and
+ * keeps the best few, so a level costs at most beamWidth * 9 node
+ * evaluations no matter how deep the search goes.
+ *
+ * The search is anytime: it stops at the deadline or the node limit,
+ * whichever comes first, and answers with the first step of the best
+ * plan of the deepest level it finished. Only when not even the first
+ * level fits does decide() give up and leave the choice to the caller.
+ * With the deadline out of reach, the result depends only on the
+ * problem and the node limit.
+ */
+class EnemySearch {
+public:
+    static constexpr int MAX_DEPTH = 16;    ///< Deepest plan
+    static constexpr int MAX_BEAM = 32;     ///< Widest beam
+    
+    /**
+     * @brief Constructor for EnemySearch
+     * @param beamWidth Plans kept per level (clamped to MAX_BEAM)
+     * @param depth Moves per plan (clamped to MAX_DEPTH)
+     */
+    EnemySearch(int beamWidth = 8, int depth = 12);
+    
+    /**
+     * @brief Choose the next action of an enemy
+     * @param problem What the enemy knows
+     * @param deadline Time by which the search has to stop
+     * @param maxNodes Node evaluations allowed
+     * @param action Output, set only on success
+     * @return True if at least one search level finished
+     */
+    bool decide(const SearchProblem& problem,
+                std::chrono::steady_clock::time_point deadline,
+                int maxNodes,
+                EnemyAction& action);
+    
+    /**
+     * @brief Get the node evaluations of the last decide() call
+     * @return Node count
+     */
+    int getNodeCount() const;
+    
+    /**
+     * @brief Get the deepest level the last decide() call finished
+     * @return Plan length in moves
+     */
+    int getCompletedDepth() const;
+
+private:
+    static const int MAX_OWN_BOMBS = 2; ///< Planned bombs tracked per plan
+    
+    /**
+     * @struct Node
+     * @brief One plan: where it leaves the enemy and what it dropped
+     */
+    struct Node {
+        int cell;                               ///< Padded index of the enemy
+        int firstDirection;                     ///< First step of the plan
+        bool firstBomb;                         ///< Whether the first step drops a bomb
+        bool caught;                            ///< Whether the plan reached the player
+        int bombsLeft;                          ///< Bombs still in hand
+        std::uint64_t bombReadyTick;            ///< First tick another bomb may drop
+        int ownCount;                           ///< Planned bombs
+        int ownCells[MAX_OWN_BOMBS];            ///< Padded index of each planned bomb
+        std::uint64_t ownTicks[MAX_OWN_BOMBS];  ///< Detonation tick of each planned bomb
+        int score;                              ///< Evaluation, higher is better
+    };
+    
+    /**
+     * @brief Expand every plan of the beam by one move
+     * @param depth Moves already in the plans
+     * @return False if the budget ran out or no plan survived
+     */
+    bool expand(int depth);
+    
+    /**
+     * @brief Check if a plan's enemy can step onto a cell
+     * @param node Plan
+     * @param cell Padded index
+     * @param arrival Tick of the step
+     * @return True if nothing blocks the cell
+     */
+    bool isOpen(const Node& node, int cell, std::uint64_t arrival) const;
+    
+    /**
+     * @brief Check if fire reaches a cell while the enemy stands there
+     * @param node Plan
+     * @param cell Padded index
+     * @param from First tick on the cell
+     * @param to Last tick on the cell
+     * @return True if the enemy would burn
+     */
+    bool burns(const Node& node, int cell, std::uint64_t from, std::uint64_t to) const;
+    
+    /**
+     * @brief Check if a bomb's rays reach a cell
+     * @param bombCell Padded index of the bomb
+     * @param cell Padded index
+     * @return True if the cell is in the footprint
+     */
+    bool covers(int bombCell, int cell) const;
+    
+    /**
+     * @brief Score a plan
+     * @param node Plan
+     * @param arrival Tick the plan ends
+     * @return Evaluation, higher is better
+     */
+    int evaluate(const Node& node, std::uint64_t arrival) const;
+    
+    /**
+     * @brief Check whether the budget is spent
+     * @return True if the search has to stop
+     */
+    bool outOfBudget() const;
+    
+    int beamWidth;                          ///< Plans kept per level
+    int depth;                              ///< Moves per plan
+    const SearchProblem* problem;           ///< Problem of the running search
+    std::chrono::steady_clock::time_point deadline; ///< Deadline of the running search
+    int maxNodes;                           ///< Node limit of the running search
+    int nodeCount;                          ///< Nodes evaluated so far
+    int completedDepth;                     ///< Deepest level finished
+    int offsets[4];                         ///< Index steps to the four neighbours
+    std::vector<Node> beam;                 ///< Plans of the current level
+    std::vector<Node> children;             ///< Expansions of the current level
+};
+
+#endif // ENEMY_SEARCH_HPP
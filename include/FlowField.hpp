@@ -0,0 +1,141 @@
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BombPool.hpp"
+#include "Map.hpp"
+
+/**
+ * @class FlowField
+ * @brief Walking distance from every cell to one target cell
+ *
+ * A breadth-first sweep from the target (the player) over walkable,
+ * bomb-free cells gives every cell its distance, so any number of
+ * enemies find their way with an O(1) lookup per neighbour instead of a
+ * search each. Cells are indexed like the padded Map buffer.
+ *
+ * The field is only brought up to date when update() is called, and
+ * only if something it depends on changed since: a new target means a
+ * full sweep, and so does a cell closing (a bomb placed), since that
+ * can make distances longer anywhere behind it. Cells opening (a block
+ * destroyed, a bomb gone) can only make paths shorter, so those are
+ * relaxed outwards from the opened cells alone.
+ *
+ * On large maps the field can be cut off at a walking distance from the
+ * target (setMaxDistance()), so a sweep costs the same however big the
+ * map is; cells further away read UNREACHABLE, and the distances inside
+ * the limit are still exact.
+ */
+class FlowField {
+public:
+    static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;  ///< Distance of cells with no path
+    
+    /**
+     * @brief Constructor for FlowField
+     */
+    FlowField();
+    
+    /**
+     * @brief Size the field for a map and mark it for a full sweep
+     * @param cellCount Number of cells in the padded map buffer
+     * @param stride Padded row length of the map
+     */
+    void reset(std::size_t cellCount, int stride);
+    
+    /**
+     * @brief Stop the field at a walking distance from the target
+     * @param distance Furthest distance kept (UNREACHABLE - 1: no limit)
+     */
+    void setMaxDistance(std::uint32_t distance);
+    
+    /**
+     * @brief Set the target cell (a full sweep follows if it moved)
+     * @param index Padded buffer index of the target
+     */
+    void setTarget(int index);
+    
+    /**
+     * @brief Report a cell that became passable
+     * @param index Padded buffer index
+     */
+    void openCell(int index);
+    
+    /**
+     * @brief Report a cell that became impassable
+     * @param index Padded buffer index
+     */
+    void closeCell(int index);
+    
+    /**
+     * @brief Force a full sweep on the next update
+     */
+    void invalidate();
+    
+    /**
+     * @brief Bring the distances up to date with the reported changes
+     * @param map Map the field covers
+     * @param bombGrid Bomb handle per padded index (INVALID_HANDLE if none)
+     */
+    void update(const Map& map, const std::vector<BombPool::Handle>& bombGrid);
+    
+    /**
+     * @brief Get the walking distance from a cell to the target
+     * @param index Padded buffer index
+     * @return Steps to the target, or UNREACHABLE
+     */
+    std::uint32_t getDistance(int index) const;
+    
+    /**
+     * @brief Get the number of full sweeps done so far
+     * @return Full sweep count
+     */
+    std::uint64_t getSweepCount() const;
+
+private:
+    /**
+     * @brief Check if a path can go through a cell
+     * @param map Map the field covers
+     * @param bombGrid Bomb handle per padded index
+     * @param index Padded buffer index
+     * @return True for walkable cells without a bomb
+     */
+    static bool isPassable(const Map& map, const std::vector<BombPool::Handle>& bombGrid, int index);
+    
+    /**
+     * @brief Recompute every distance from the target
+     * @param map Map the field covers
+     * @param bombGrid Bomb handle per padded index
+     */
+    void sweep(const Map& map, const std::vector<BombPool::Handle>& bombGrid);
+    
+    /**
+     * @brief Lower distances outwards from the cells already queued
+     * @param map Map the field covers
+     * @param bombGrid Bomb handle per padded index
+     */
+    void relax(const Map& map, const std::vector<BombPool::Handle>& bombGrid);
+    
+    std::vector<std::uint32_t> distances;   ///< Distance per padded index
+    std::vector<int> queue;                 ///< BFS queue, reused between updates
+    std::vector<int> openedCells;           ///< Cells opened since the last update
+    std::vector<int> reachedCells;          ///< Cells given a distance since the last sweep
+    int offsets[4];                         ///< Index steps to the four neighbours
+    int target;                             ///< Target cell, -1 if none yet
+    int sweptTarget;                        ///< Target of the last full sweep
+    std::uint32_t maxDistance;              ///< Furthest distance kept
+    bool needsSweep;                        ///< Whether the next update must sweep
+    std::uint64_t sweepCount;               ///< Full sweeps done
+};
+
+/**
+ * @brief Get the walking distance from a cell to the target
+ * @param index Padded buffer index
+ * @return Steps to the target, or UNREACHABLE
+ */
+inline std::uint32_t FlowField::getDistance(int index) const {
+    return distances[index];
+}
+
+#endif // FLOW_FIELD_HPP
@@ -3,19 +3,41 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
-#include <vector>
-#include "Player.hpp"
-#include "Enemy.hpp"
-#include "Bomb.hpp"
-#include "Map.hpp"
-#include "PowerUp.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "GameSnapshot.hpp"
+#include "InputReplay.hpp"
+#include "Profiler.hpp"
+#include "Simulation.hpp"
+#include "TickScheduler.hpp"
+#include "SpriteBatch.hpp"
+#include "TileMapRenderer.hpp"
+#include "TripleBuffer.hpp"
 
 /**
  * @class Game
  * @brief Main game class that manages the game loop and all game components
  * 
- * This class handles the main game loop, input processing, rendering,
- * and coordination between Player, Bomb, and Map objects.
+ * This class is the SFML front end of the game: it owns the window and
+ * audio, translates keyboard state into SimulationInput, advances the
+ * Simulation and renders its state.
+ * 
+ * The Simulation is advanced on a dedicated thread which publishes a
+ * GameSnapshot after every batch of ticks through a lock-free
+ * TripleBuffer. The main thread polls window events, forwards input
+ * through atomics and draws the newest snapshot; the two threads never
+ * wait for each other.
+ * 
+ * Moving entities are drawn between their previous and current cell,
+ * interpolated by how far real time has progressed into the next tick,
+ * so the simulation can run at a low fixed rate (20 Hz by default) while
+ * the display renders at its own refresh rate.
+ * 
+ * The input of every tick can be recorded to a replay file together with
+ * the match seed, and a replay can be played back instead of the keyboard.
  */
 class Game {
 public:
@@ -23,14 +45,47 @@ public:
      * @brief Constructor for Game
      * @param windowWidth Width of the game window
      * @param windowHeight Height of the game window
+     * @param tickRate Simulation ticks per second
      */
-    Game(int windowWidth = 800, int windowHeight = 600);
+    Game(int windowWidth = 800, int windowHeight = 600, int tickRate = 20);
     
     /**
      * @brief Destructor
      */
     ~Game();
     
+    /**
+     * @brief Set the seed of the match (call before initialize)
+     * @param seed Simulation seed
+     */
+    void setSeed(std::uint32_t seed);
+    
+    /**
+     * @brief Choose how enemies decide (call before initialize)
+     * @param ai Enemy AI
+     * @param budget Limits of the search enemy AI
+     */
+    void setEnemyAi(EnemyAi ai, const SearchBudget& budget = SearchBudget());
+    
+    /**
+     * @brief Set the threads deciding for the enemies (call before initialize)
+     * @param count Threads including the simulation thread
+     */
+    void setWorkerThreads(int count);
+    
+    /**
+     * @brief Record the input of the match (call before initialize)
+     * @param path Replay file written when the game ends
+     */
+    void recordTo(const std::string& path);
+    
+    /**
+     * @brief Play a recorded match instead of reading the keyboard (call before initialize)
+     * @param path Replay file
+     * @return True if the replay was loaded
+     */
+    bool loadReplay(const std::string& path);
+    
     /**
      * @brief Initialize the game
      * @return True if initialization was successful
@@ -49,59 +104,74 @@ public:
 
 private:
     /**
-     * @brief Process user input
+     * @brief Poll window events and forward input to the simulation thread
      */
-    void processInput();
+    void handleEvents();
     
     /**
-     * @brief Update game state
-     * @param deltaTime Time elapsed since last update
+     * @brief Start the simulation thread
      */
-    void update(float deltaTime);
+    void startSimulation();
     
     /**
-     * @brief Render the game
+     * @brief Stop the simulation thread and wait for it to finish
      */
-    void render();
+    void stopSimulation();
     
     /**
-     * @brief Handle bomb explosions
-     * @param bomb The bomb that exploded
+     * @brief Body of the simulation thread
      */
-    void handleBombExplosion(const Bomb& bomb);
+    void simulationLoop();
     
     /**
-     * @brief Check collisions between player and explosions
+     * @brief Translate held keys into simulation input
      */
-    void checkPlayerCollisions();
+    void processInput();
     
     /**
-     * @brief Check collisions between enemies and explosions
+     * @brief Advance the game state by one simulation tick
      */
-    void checkEnemyCollisions();
+    void update();
     
     /**
-     * @brief Handle player death and respawn
+     * @brief Play sounds for the events since the previous snapshot
      */
-    void handlePlayerDeath();
+    void playEventSounds();
     
     /**
-     * @brief Draw the map using ASCII symbols
+     * @brief Render the game
+     */
+    void render();
+    
+    /**
+     * @brief Draw the latest snapshot into the window
+     */
+    void renderFrame();
+    
+    /**
+     * @brief Draw the map from the cached tile vertex array
      */
     void drawMap();
     
     /**
-     * @brief Draw the player
+     * @brief Add the player to the sprite batch
      */
     void drawPlayer();
     
     /**
-     * @brief Draw the enemies
+     * @brief Add the enemies to the sprite batch
      */
     void drawEnemies();
     
     /**
-     * @brief Draw the bombs
+     * @brief Get the screen position of an entity between the last two ticks
+     * @param entity Entity with its previous and current cell
+     * @return Top-left pixel of the entity's cell at interpolationAlpha
+     */
+    sf::Vector2f getInterpolatedPosition(const SnapshotEntity& entity) const;
+    
+    /**
+     * @brief Add the bombs to the sprite batch
      */
     void drawBombs();
     
@@ -120,32 +190,51 @@ private:
      */
     void drawYouWin();
     
-    /**
-     * @brief Check if all enemies are dead (victory condition)
-     */
-    void checkVictory();
-    
     /**
      * @brief Draw HUD (lives, etc.)
      */
     void drawHUD();
     
     /**
-     * @brief Draw power-ups
+     * @brief Add the power-ups to the sprite batch
      */
     void drawPowerUps();
     
     /**
-     * @brief Check collisions between player and power-ups
+     * @brief Append an axis-aligned rectangle to a triangle vertex array
+     * @param vertices Vertex array using PrimitiveType::Triangles
+     * @param x Left edge
+     * @param y Top edge
+     * @param width Rectangle width
+     * @param height Rectangle height
+     * @param color Fill color
+     */
+    static void appendRect(sf::VertexArray& vertices, float x, float y,
+                           float width, float height, sf::Color color);
+    
+    /**
+     * @brief Build the game over screen geometry
+     */
+    void buildGameOverScreen();
+    
+    /**
+     * @brief Build the you win screen geometry
+     */
+    void buildYouWinScreen();
+    
+    /**
+     * @brief Build the HUD geometry for a number of lives
+     * @param lives Lives to show
      */
-    void checkPowerUpCollisions();
+    void buildHUD(int lives);
     
+#ifdef BOMBERMAN_PROFILING
     /**
-     * @brief Spawn a power-up at a position (random chance)
-     * @param x X coordinate
-     * @param y Y coordinate
+     * @brief Draw the frame time graph of the profiler
      */
-    void spawnPowerUp(int x, int y);
+    void drawProfilerOverlay();
+#endif
+
     
     /**
      * @brief Initialize audio system
@@ -160,24 +249,35 @@ private:
     void playSound(const std::string& soundName);
 
     sf::RenderWindow* window;           ///< SFML render window
-    Player* player;                     ///< Player object
-    std::vector<Enemy*> enemies;       ///< List of enemies
-    Map* map;                          ///< Game map
-    std::vector<Bomb*> bombs;          ///< List of active bombs
-    std::vector<Bomb*> bombsToRemove;  ///< Bombs to remove after update
-    std::vector<PowerUp*> powerUps;    ///< List of power-ups on the map
+    Simulation* simulation;             ///< Headless game logic
+    TickScheduler scheduler;            ///< Fixed-rate tick scheduling
+    TileMapRenderer tileMap;            ///< Cached map geometry
+    SpriteBatch sprites;                ///< Entity sprites of the current frame
+    sf::VertexArray gameOverScreen;     ///< Cached game over overlay
+    sf::VertexArray youWinScreen;       ///< Cached victory overlay
+    sf::VertexArray hud;                ///< Cached HUD geometry
     
     int windowWidth;                   ///< Window width
     int windowHeight;                  ///< Window height
     int cellSize;                      ///< Size of each cell in pixels
     int mapWidth;                      ///< Map width in cells
     int mapHeight;                     ///< Map height in cells
+    int enemyCount;                    ///< Number of enemies
+    std::uint32_t seed;                ///< Simulation seed
+    EnemyAi enemyAi;                   ///< How enemies decide
+    SearchBudget searchBudget;         ///< Limits of the search enemy AI
+    int workerThreads;                 ///< Threads deciding for the enemies
     
     bool isRunning;                    ///< Game running state
-    bool gameOver;                     ///< Game over state
-    bool youWin;                       ///< Victory state
-    sf::Clock clock;                   ///< Clock for delta time calculation
-    sf::Clock moveClock;               ///< Clock for movement timing
+    sf::Clock gameClock;               ///< Time base shared by both threads
+    float interpolationAlpha;          ///< Fraction of a tick since the drawn snapshot
+    
+#ifdef BOMBERMAN_PROFILING
+    // Profiler overlay (F3 toggles it, F4 exports a Chrome trace)
+    bool profilerOverlayVisible;       ///< Whether the frame graph is drawn
+    sf::VertexArray profilerOverlay;   ///< Frame graph geometry
+    std::vector<FrameSample> profilerFrames; ///< Recent frames copied from the profiler
+#endif
     sf::Font font;                     ///< Font for text rendering
     
     // Audio system
@@ -194,17 +294,27 @@ private:
     sf::Sound* powerUpSound;           ///< Sound for power-up collection
     bool audioEnabled;                 ///< Whether audio is enabled
     
-    // Movement flags to handle continuous movement
-    bool moveUpPressed;
-    bool moveDownPressed;
-    bool moveLeftPressed;
-    bool moveRightPressed;
-    float moveTimer;                   ///< Timer for movement delay
-    const float moveDelay = 0.15f;     ///< Delay between movements in seconds
-    
-    // Player starting position for respawn
-    int playerStartX;
-    int playerStartY;
+    // Simulation thread
+    std::thread simulationThread;      ///< Runs simulationLoop()
+    std::atomic<bool> simulationRunning; ///< Cleared to stop the simulation thread
+    TripleBuffer<GameSnapshot> snapshots; ///< Latest simulation state for rendering
+    CellChangeLog cellChanges;         ///< Map cells changed per snapshot (simulation thread)
+    std::array<std::uint64_t, SIMULATION_EVENT_TYPES> playedEvents; ///< Event counts already played
+    
+    // Movement flags to handle continuous movement (written by the main thread)
+    std::atomic<bool> moveUpPressed;
+    std::atomic<bool> moveDownPressed;
+    std::atomic<bool> moveLeftPressed;
+    std::atomic<bool> moveRightPressed;
+    std::atomic<std::uint32_t> bombPresses; ///< Space presses so far
+    std::uint32_t bombPressesHandled;  ///< Space presses already turned into bombs
+    SimulationInput input;             ///< Input for the next simulation step
+    
+    // Input recording and playback (used by the simulation thread while it runs)
+    InputReplay replay;                ///< Recorded or loaded input
+    std::string recordPath;            ///< Where to save the recording, empty if not recording
+    bool replaying;                    ///< Whether input comes from the replay
+    int hudLives;                      ///< Lives count the HUD was built for
 };
 
 #endif // GAME_HPP
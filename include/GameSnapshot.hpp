@@ -0,0 +1,134 @@
+#ifndef GAME_SNAPSHOT_HPP
+#define GAME_SNAPSHOT_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Map.hpp"
+#include "PowerUp.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @struct SnapshotEntity
+ * @brief Position of an entity in a snapshot
+ */
+struct SnapshotEntity {
+    int x;      ///< X coordinate
+    int y;      ///< Y coordinate
+    int prevX;  ///< X coordinate one tick earlier
+    int prevY;  ///< Y coordinate one tick earlier
+};
+
+/**
+ * @struct SnapshotPowerUp
+ * @brief Position and type of a power-up in a snapshot
+ */
+struct SnapshotPowerUp {
+    int x;              ///< X coordinate
+    int y;              ///< Y coordinate
+    PowerUpType type;   ///< Power-up type
+};
+
+/**
+ * @class CellChangeLog
+ * @brief Map cells changed per published snapshot (simulation thread only)
+ *
+ * record() collects the cells each step changed, as listed by
+ * Map::getDirtyCells(), until the next snapshot is captured; the last
+ * LENGTH lists are kept by snapshot sequence number. A snapshot slot
+ * being refilled only has to copy the cells changed since it was last
+ * filled, not the whole map.
+ */
+class CellChangeLog {
+public:
+    static constexpr int LENGTH = 4;    ///< Published change lists kept
+    
+    /**
+     * @brief Constructor for CellChangeLog
+     */
+    CellChangeLog();
+    
+    /**
+     * @brief Add the cells changed by the last simulation step
+     * @param map Map right after the step
+     */
+    void record(const Map& map);
+    
+    /**
+     * @brief Get the sequence number of the last published snapshot
+     * @return Sequence number, 0 before the first one
+     */
+    std::uint64_t getPublished() const;
+    
+    /**
+     * @brief Get the cells changed between a snapshot and the one before it
+     * @param sequence Sequence number, one of the last LENGTH published
+     * @return Row-major cell indices
+     */
+    const std::vector<int>& getChanges(std::uint64_t sequence) const;
+    
+    /**
+     * @brief Get the cells changed since the last published snapshot
+     * @return Row-major cell indices, each listed once
+     */
+    const std::vector<int>& getPending() const;
+    
+    /**
+     * @brief File the pending changes under the next sequence number
+     */
+    void publish();
+
+private:
+    std::uint64_t published;                            ///< Sequence number of the last snapshot
+    std::vector<int> pending;                           ///< Cells changed since it
+    std::vector<std::uint8_t> pendingFlags;             ///< Whether each cell is in pending
+    std::array<std::vector<int>, LENGTH> history;       ///< Changes of the last snapshots, by sequence % LENGTH
+};
+
+/**
+ * @struct GameSnapshot
+ * @brief Everything a front end needs to draw one simulation tick
+ *
+ * A snapshot is a plain copy of the visible state, so it can be handed to
+ * another thread while the simulation keeps running. capture() reuses
+ * the vectors' storage, so refilling a snapshot does not allocate once
+ * the entity counts have been reached. Snapshots are numbered in the
+ * order they are published; a slot's cells are brought up to date from
+ * the CellChangeLog, so only the cells changed since the slot was last
+ * filled are copied, and changedCells tells the renderer which cells
+ * differ from the snapshot published just before.
+ * 
+ * Moving entities carry their position one tick earlier as well, so the
+ * renderer can interpolate between the two ticks.
+ */
+struct GameSnapshot {
+    std::uint64_t tick = 0;             ///< Tick the snapshot was taken at
+    std::int64_t tickTime = 0;          ///< Front end clock time the tick became due, in microseconds
+    std::uint64_t sequence = 0;         ///< Publish order, from 1 (0: never filled)
+    int mapWidth = 0;                   ///< Map width in cells
+    int mapHeight = 0;                  ///< Map height in cells
+    std::vector<CellType> cells;        ///< Row-major cells, without the border
+    std::vector<int> changedCells;      ///< Cells that differ from the previous snapshot
+    
+    SnapshotEntity player = {0, 0, 0, 0}; ///< Player position
+    bool playerAlive = false;           ///< Whether the player is drawn
+    int lives = 0;                      ///< Player lives
+    
+    std::vector<SnapshotEntity> enemies;    ///< Alive enemies
+    std::vector<SnapshotEntity> bombs;      ///< Active bombs
+    std::vector<SnapshotPowerUp> powerUps;  ///< Uncollected power-ups
+    
+    bool gameOver = false;              ///< Match lost
+    bool victory = false;               ///< Match won
+    std::array<std::uint64_t, SIMULATION_EVENT_TYPES> eventCounts = {}; ///< Events since the match started
+    
+    /**
+     * @brief Copy the visible state of a simulation and number the snapshot
+     * @param simulation Simulation to copy
+     * @param changes Cells changed since the previous snapshots; the
+     * pending ones are published with this snapshot
+     */
+    void capture(const Simulation& simulation, CellChangeLog& changes);
+};
+
+#endif // GAME_SNAPSHOT_HPP
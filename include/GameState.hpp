@@ -0,0 +1,171 @@
+#ifndef GAME_STATE_HPP
+#define GAME_STATE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "Random.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @struct PlayerState
+ * @brief Packed copy of a Player
+ */
+struct PlayerState {
+    std::int16_t x;             ///< X coordinate
+    std::int16_t y;             ///< Y coordinate
+    std::int16_t prevX;         ///< X coordinate at the start of the tick
+    std::int16_t prevY;         ///< Y coordinate at the start of the tick
+    std::int16_t startX;        ///< Respawn X coordinate
+    std::int16_t startY;        ///< Respawn Y coordinate
+    std::int16_t lives;         ///< Lives remaining
+    std::int16_t bombCount;     ///< Bombs in hand
+    std::int16_t maxBombs;      ///< Bomb capacity
+    std::int16_t bombRange;     ///< Explosion range
+    bool alive;                 ///< Alive status
+};
+
+/**
+ * @struct EnemyState
+ * @brief Packed copy of an Enemy
+ */
+struct EnemyState {
+    std::int16_t x;             ///< X coordinate
+    std::int16_t y;             ///< Y coordinate
+    std::int16_t prevX;         ///< X coordinate at the start of the tick
+    std::int16_t prevY;         ///< Y coordinate at the start of the tick
+    std::int32_t moveTimer;     ///< Ticks since the last movement decision
+    std::int32_t bombTimer;     ///< Ticks since the last bomb placement
+    std::int8_t bombCount;      ///< Bombs in hand
+    std::int8_t maxBombs;       ///< Bomb capacity
+    std::int8_t lastDirection;  ///< Last movement direction
+    bool alive;                 ///< Alive status
+};
+
+/**
+ * @struct BombState
+ * @brief Packed copy of a Bomb
+ */
+struct BombState {
+    std::uint8_t x;             ///< X coordinate
+    std::uint8_t y;             ///< Y coordinate
+    std::int8_t owner;          ///< Owning enemy index, or -1 for the player
+    std::uint8_t range;         ///< Explosion range (capped at 255, more than any map allows)
+    std::uint16_t fuse;         ///< Ticks left before the bomb explodes
+};
+
+/**
+ * @struct PowerUpState
+ * @brief Packed copy of a PowerUp
+ */
+struct PowerUpState {
+    std::uint8_t x;             ///< X coordinate
+    std::uint8_t y;             ///< Y coordinate
+    PowerUpType type;           ///< Power-up type
+};
+
+/**
+ * @struct ExplosionState
+ * @brief A burning cell
+ */
+struct ExplosionState {
+    std::uint16_t index;        ///< Padded map buffer index
+    std::uint16_t remaining;    ///< Ticks until the cell goes out
+};
+
+/**
+ * @struct GameState
+ * @brief Complete state of a match in one flat, fixed-capacity block
+ *
+ * A GameState holds no pointers and no heap storage, so copying it is a
+ * single memcpy: search code and rollback buffers can clone positions
+ * millions of times per second. Simulation::saveState() packs a running
+ * match into it and Simulation::restoreState() rebuilds the match from
+ * it; a restored match continues exactly like the original, random
+ * streams included.
+ *
+ * Walls are not stored (every map of a given size has the same walls);
+ * destructible blocks are one bit per cell of the padded map buffer.
+ * Matches larger than the capacities below cannot be saved.
+ */
+struct GameState {
+    static const int MAX_MAP_WIDTH = 31;    ///< Widest map that fits
+    static const int MAX_MAP_HEIGHT = 31;   ///< Tallest map that fits
+    static const int BLOCK_WORDS = ((MAX_MAP_WIDTH + 2) * (MAX_MAP_HEIGHT + 2) + 63) / 64; ///< Words of the block plane
+    static const int MAX_ENEMIES = 16;      ///< Enemies that fit
+    static const int MAX_BOMBS = 32;        ///< Simultaneous bombs that fit
+    static const int MAX_POWERUPS = 32;     ///< Power-ups on the map that fit
+    static const int MAX_EXPLOSIONS = 128;  ///< Burning cells that fit
+
+    // Match progress
+    std::uint64_t tick;                     ///< Ticks simulated
+    std::uint64_t eventCounts[SIMULATION_EVENT_TYPES]; ///< Events since the match started
+    Random aiRandom;                        ///< Enemy AI random stream
+    Random lootRandom;                      ///< Power-up drop random stream
+    std::int32_t moveTimer;                 ///< Ticks since the last player movement
+    std::int32_t enemyMoveTimer;            ///< Ticks since the last enemy movement
+    bool gameOver;                          ///< Match lost
+    bool victory;                           ///< Match won
+
+    // Sizes and entity counts
+    std::uint8_t mapWidth;                  ///< Map width in cells
+    std::uint8_t mapHeight;                 ///< Map height in cells
+    std::uint8_t enemyCount;                ///< Entries used in enemies
+    std::uint8_t bombCount;                 ///< Entries used in bombs
+    std::uint8_t powerUpCount;              ///< Entries used in powerUps
+    std::uint16_t explosionCount;           ///< Entries used in explosions
+
+    PlayerState player;                     ///< The player
+    EnemyState enemies[MAX_ENEMIES];        ///< Enemies in Simulation order
+    BombState bombs[MAX_BOMBS];             ///< Active bombs in pool order
+    PowerUpState powerUps[MAX_POWERUPS];    ///< Uncollected power-ups
+    ExplosionState explosions[MAX_EXPLOSIONS]; ///< Burning cells, soonest to go out first
+    std::uint64_t blockWords[BLOCK_WORDS];  ///< BLOCK cells (bit per padded map index)
+
+    /**
+     * @brief Copy the state
+     * @return Independent copy
+     */
+    GameState clone() const;
+
+    /**
+     * @brief Copy the state into a slot (e.g. of a rollback buffer)
+     * @param slot Destination
+     */
+    void save(GameState& slot) const;
+
+    /**
+     * @brief Overwrite the state with a saved one
+     * @param slot Source
+     */
+    void restore(const GameState& slot);
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must stay copyable with memcpy");
+
+/**
+ * @brief Copy the state
+ * @return Independent copy
+ */
+inline GameState GameState::clone() const {
+    return *this;
+}
+
+/**
+ * @brief Copy the state into a slot (e.g. of a rollback buffer)
+ * @param slot Destination
+ */
+inline void GameState::save(GameState& slot) const {
+    std::memcpy(static_cast<void*>(&slot), this, sizeof(GameState));
+}
+
+/**
+ * @brief Overwrite the state with a saved one
+ * @param slot Source
+ */
+inline void GameState::restore(const GameState& slot) {
+    std::memcpy(static_cast<void*>(this), &slot, sizeof(GameState));
+}
+
+#endif // GAME_STATE_HPP
@@ -0,0 +1,111 @@
+#ifndef HIERARCHICAL_PATHFINDER_HPP
+#define HIERARCHICAL_PATHFINDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ClusterGraph.hpp"
+#include "Map.hpp"
+
+/**
+ * @class HierarchicalPathfinder
+ * @brief Long-distance path queries over a ClusterGraph (HPA*)
+ *
+ * A query searches the start's cluster and the goal's cluster cell by
+ * cell, which links the two cells to the entrances of their clusters,
+ * then runs A* over the entrance graph with the Manhattan distance,
+ * inflated by 1/8, as the estimate. Only a handful of nodes per cluster
+ * are touched, so the cost grows with the number of clusters on the way
+ * rather than with the map area. The answer is the length of the path
+ * found and its first step, which is all a walking enemy needs. Paths
+ * are at most 1/8 longer than the shortest (in practice a fraction of a
+ * percent), and cells with no path between them are turned away by the
+ * graph's connected sets without a search.
+ *
+ * The pathfinder only holds scratch space: the graph is read, never
+ * written, so one pathfinder per thread can query the same graph at once.
+ */
+class HierarchicalPathfinder {
+public:
+    static constexpr std::uint32_t NO_PATH = 0xFFFFFFFFu;  ///< Length of a path that does not exist
+    
+    /**
+     * @brief Constructor for HierarchicalPathfinder
+     */
+    HierarchicalPathfinder();
+    
+    /**
+     * @brief Find a path between two cells
+     * @param graph Cluster graph of the map
+     * @param map Map the graph covers
+     * @param from Padded index of the start
+     * @param to Padded index of the goal
+     * @param firstDirection Output: 0=up, 1=down, 2=left, 3=right, -1 if no step
+     * @return Steps to the goal, or NO_PATH
+     */
+    std::uint32_t findPath(const ClusterGraph& graph, const Map& map, int from, int to, int& firstDirection);
+    
+    /**
+     * @brief Size the per-node scratch space ahead of the first query
+     * @param nodeCapacity Node capacity of the graph to search
+     */
+    void reserve(std::size_t nodeCapacity);
+    
+    /**
+     * @brief Get the nodes expanded by the last query
+     * @return Node count
+     */
+    int getExpandedCount() const;
+
+private:
+    static constexpr std::uint16_t NOT_REACHED = 0xFFFF;   ///< Local distance of cells not reached
+    static const int ESTIMATE_SHIFT = 3;                    ///< Estimate inflated by 1 / 2^ESTIMATE_SHIFT
+    static const int HEADROOM_SHIFT = 2;                    ///< Spare node room, 1 / 2^HEADROOM_SHIFT of the capacity
+    
+    /**
+     * @struct OpenEntry
+     * @brief A node waiting in the A* open list
+     */
+    struct OpenEntry {
+        std::uint32_t estimate;     ///< Steps so far plus the estimate to the goal
+        std::uint32_t cost;         ///< Steps so far
+        int node;                   ///< Node id
+    };
+    
+    /**
+     * @brief Walk a cluster from a cell, recording distances and first steps
+     * @param graph Cluster graph of the map
+     * @param map Map the graph covers
+     * @param cell Padded index to start from
+     * @param cluster Cluster of the cell
+     * @param distance Output, distance per local cell
+     * @param origin Output, first step per local cell (nullptr to skip)
+     */
+    void searchCluster(const ClusterGraph& graph, const Map& map, int cell, int cluster,
+                       std::vector<std::uint16_t>& distance, std::vector<std::int8_t>* origin);
+    
+    /**
+     * @brief Offer a node a new path
+     * @param node Node id
+     * @param cost Steps to the node
+     * @param direction First step of the path
+     */
+    void relax(int node, std::uint32_t cost, int direction);
+    
+    const ClusterGraph* graph;              ///< Graph of the running query
+    const Map* map;                         ///< Map of the running query
+    int goalX;                              ///< Goal column of the running query
+    int goalY;                              ///< Goal row of the running query
+    int expandedCount;                      ///< Nodes expanded by the last query
+    std::uint32_t generation;               ///< Query number, marks valid costs
+    std::vector<std::uint32_t> costs;       ///< Best steps per node
+    std::vector<std::uint32_t> stamps;      ///< Query that set each cost
+    std::vector<std::int8_t> origins;       ///< First step per node
+    std::vector<OpenEntry> open;            ///< A* open list (binary heap)
+    std::vector<std::uint16_t> startDistance; ///< Local distances from the start
+    std::vector<std::int8_t> startOrigin;   ///< Local first steps from the start
+    std::vector<std::uint16_t> goalDistance; ///< Local distances to the goal
+    std::vector<int> queue;                 ///< Scratch BFS queue
+};
+
+#endif // HIERARCHICAL_PATHFINDER_HPP
@@ -0,0 +1,164 @@
+#ifndef INPUT_REPLAY_HPP
+#define INPUT_REPLAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.hpp"
+
+/**
+ * @struct ReplayHeader
+ * @brief Everything besides the input needed to reproduce a match
+ */
+struct ReplayHeader {
+    std::uint32_t seed = 1;     ///< Simulation seed
+    int tickRate = 60;          ///< Simulation ticks per second
+    int mapWidth = 21;          ///< Map width in cells
+    int mapHeight = 15;         ///< Map height in cells
+    int enemyCount = 3;         ///< Number of enemies
+    EnemyAi enemyAi = EnemyAi::STANDARD; ///< How enemies decide
+    SearchBudget searchBudget;  ///< Limits of the search enemy AI
+};
+
+/**
+ * @class InputReplay
+ * @brief Records the input of every simulation tick and plays it back
+ *
+ * The Simulation is deterministic for a given seed, so the seed, the
+ * match settings and the SimulationInput of every tick are enough to
+ * reproduce a match exactly. Input is held for many ticks at a time, so
+ * only changes are stored: each change is one varint holding the ticks
+ * since the previous change (upper bits) and the new input flags (low 5
+ * bits). A typical change takes one or two bytes.
+ *
+ * File layout: the magic "BMRP", then varints for the format version,
+ * seed, tick rate, map width, map height, enemy count, enemy AI, search
+ * microseconds, search nodes per enemy, tick count and the byte size of
+ * the change stream, then the change stream itself. Files of older
+ * versions are rejected: they were recorded before each enemy drew from
+ * its own random generator, so their matches would play out differently.
+ *
+ * The game records and replays the search AI without a time limit, since
+ * a search cut short by the clock would depend on the speed of the
+ * machine; only the node limit bounds each search.
+ */
+class InputReplay {
+public:
+    /**
+     * @brief Constructor for InputReplay
+     */
+    InputReplay();
+    
+    /**
+     * @brief Discard any content and start recording a new match
+     * @param header Settings of the match being recorded
+     */
+    void startRecording(const ReplayHeader& header);
+    
+    /**
+     * @brief Append the input of the next tick
+     * @param input Input passed to Simulation::step
+     */
+    void record(const SimulationInput& input);
+    
+    /**
+     * @brief Write the recording to a file
+     * @param path Output file
+     * @return True if the file was written
+     */
+    bool save(const std::string& path) const;
+    
+    /**
+     * @brief Read a recording from a file and rewind it for playback
+     * @param path Input file
+     * @return True if the file was a valid recording
+     */
+    bool load(const std::string& path);
+    
+    /**
+     * @brief Restart playback from the first tick
+     */
+    void rewind();
+    
+    /**
+     * @brief Get the input of the next tick
+     * @param input Output input
+     * @return False once every recorded tick has been played
+     */
+    bool next(SimulationInput& input);
+    
+    /**
+     * @brief Get the match settings
+     * @return Header
+     */
+    const ReplayHeader& getHeader() const;
+    
+    /**
+     * @brief Get the number of recorded ticks
+     * @return Tick count
+     */
+    std::uint64_t getTickCount() const;
+    
+    /**
+     * @brief Get the size of the encoded input
+     * @return Bytes in the change stream
+     */
+    std::size_t getByteCount() const;
+
+private:
+    static const int FLAG_BITS = 5;     ///< Bits of a change holding input flags
+    static const std::uint32_t FORMAT_VERSION = 3; ///< Current file version
+    
+    /**
+     * @brief Pack an input into flag bits
+     * @param input Input to pack
+     * @return Flags (up, down, left, right, bomb from bit 0)
+     */
+    static std::uint8_t encodeFlags(const SimulationInput& input);
+    
+    /**
+     * @brief Unpack flag bits into an input
+     * @param flags Packed flags
+     * @return Input
+     */
+    static SimulationInput decodeFlags(std::uint8_t flags);
+    
+    /**
+     * @brief Append a varint to a byte buffer
+     * @param out Buffer
+     * @param value Value to encode
+     */
+    static void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value);
+    
+    /**
+     * @brief Decode a varint from a byte buffer
+     * @param in Buffer
+     * @param position Read position, advanced past the varint
+     * @param value Decoded value
+     * @return False if the buffer ends inside the varint or it is too long
+     */
+    static bool readVarint(const std::vector<std::uint8_t>& in, std::size_t& position,
+                           std::uint64_t& value);
+    
+    /**
+     * @brief Decode the next change of the stream, if any
+     */
+    void fetchChange();
+    
+    ReplayHeader header;                ///< Match settings
+    std::vector<std::uint8_t> changes;  ///< Encoded input changes
+    std::uint64_t tickCount;            ///< Ticks recorded
+    std::uint64_t lastChangeTick;       ///< Tick of the last change written or read
+    std::uint8_t lastFlags;             ///< Flags recorded most recently
+    
+    // Playback cursor
+    std::size_t readPosition;           ///< Next byte of the change stream
+    std::uint64_t playTick;             ///< Tick next() returns
+    std::uint8_t currentFlags;          ///< Flags in effect
+    bool hasChange;                     ///< Whether a change is pending
+    std::uint64_t changeTick;           ///< Tick of the pending change
+    std::uint8_t changeFlags;           ///< Flags of the pending change
+};
+
+#endif // INPUT_REPLAY_HPP
@@ -1,13 +1,15 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
+#include <cstdint>
 #include <vector>
+#include "Bitboard.hpp"
 
 /**
  * @enum CellType
- * @brief Types of cells in the game map
+ * @brief Types of cells in the game map (one byte per cell)
  */
-enum class CellType {
+enum class CellType : std::uint8_t {
     EMPTY,      ///< Empty space where player can walk
     WALL,       ///< Indestructible wall
     BLOCK,      ///< Destructible block
@@ -20,6 +22,19 @@ enum class CellType {
  * 
  * This class manages the game map, including walls, blocks, and explosions.
  * It handles collision detection and map updates.
+ * 
+ * Cells are stored in a single row-major buffer surrounded by a one-cell
+ * border of WALL sentinels. Any cell in [-1, width] x [-1, height] can be
+ * read without a bounds check, so code stepping one cell away from a
+ * valid position (movement, explosion rays) can use the unchecked
+ * accessors below.
+ * 
+ * Alongside the byte buffer the map keeps one Bitboard per BLOCK and
+ * EXPLOSION cell type, indexed the same way, so whole-map scans run a
+ * 64-bit word at a time.
+ * 
+ * Every cell whose type changes is recorded in a dirty list, letting
+ * consumers such as the renderer update only what changed.
  */
 class Map {
 public:
@@ -71,6 +86,72 @@ public:
      */
     bool isWalkable(int x, int y) const;
     
+    /**
+     * @brief Get the cell type without bounds checking
+     * @param x X coordinate in [-1, width]
+     * @param y Y coordinate in [-1, height]
+     * @return CellType at the position (WALL on the border)
+     */
+    CellType getCellUnchecked(int x, int y) const;
+    
+    /**
+     * @brief Set the cell type without bounds checking
+     * @param x X coordinate in [0, width)
+     * @param y Y coordinate in [0, height)
+     * @param type CellType to set
+     */
+    void setCellUnchecked(int x, int y, CellType type);
+    
+    /**
+     * @brief Check walkability without bounds checking
+     * @param x X coordinate in [-1, width]
+     * @param y Y coordinate in [-1, height]
+     * @return True if position is walkable
+     */
+    bool isWalkableUnchecked(int x, int y) const;
+    
+    /**
+     * @brief Get the cell type at a buffer index
+     * @param index Padded buffer index
+     * @return CellType at the index
+     */
+    CellType getCellAt(int index) const;
+    
+    /**
+     * @brief Set the cell type at a buffer index
+     * @param index Padded buffer index of a cell inside the map
+     * @param type CellType to set
+     */
+    void setCellAt(int index, CellType type);
+    
+    /**
+     * @brief Get the X coordinate of a buffer index
+     * @param index Padded buffer index
+     * @return X coordinate
+     */
+    int getIndexX(int index) const;
+    
+    /**
+     * @brief Get the Y coordinate of a buffer index
+     * @param index Padded buffer index
+     * @return Y coordinate
+     */
+    int getIndexY(int index) const;
+    
+    /**
+     * @brief Get the buffer index of a position
+     * @param x X coordinate in [-1, width]
+     * @param y Y coordinate in [-1, height]
+     * @return Index into the padded cell buffer
+     */
+    int getIndex(int x, int y) const;
+    
+    /**
+     * @brief Get the distance between vertically adjacent cells in the buffer
+     * @return Row stride (width + 2)
+     */
+    int getStride() const;
+    
     /**
      * @brief Check if a position is valid (within map bounds)
      * @param x X coordinate
@@ -80,17 +161,69 @@ public:
     bool isValidPosition(int x, int y) const;
     
     /**
-     * @brief Create an explosion at a position
-     * @param x X coordinate
-     * @param y Y coordinate
-     * @param range Explosion range
+     * @brief Set a cell on fire until a given tick
+     * 
+     * Expiry ticks must be passed in non-decreasing order (every explosion
+     * lasts the same number of ticks), which keeps the active list sorted.
+     * Igniting a cell that is already burning extends its lifetime.
+     * 
+     * @param index Padded buffer index of a non-wall cell
+     * @param expiryTick Tick on which the explosion disappears
+     */
+    void igniteCell(int index, std::uint64_t expiryTick);
+    
+    /**
+     * @brief Put out the explosions whose lifetime has ended
+     * @param tick Current tick
+     */
+    void expireExplosions(std::uint64_t tick);
+    
+    /**
+     * @brief Get the number of pending explosion expiries
+     * @return Entries in the active explosion list
+     */
+    std::size_t getActiveExplosionCount() const;
+    
+    /**
+     * @brief Get the tick on which a burning cell goes out
+     * @param index Padded buffer index of an EXPLOSION cell
+     * @return Expiry tick
+     */
+    std::uint64_t getExplosionExpiry(int index) const;
+    
+    /**
+     * @brief Replace the blocks and put out every explosion
+     * 
+     * Every non-wall cell becomes BLOCK or EMPTY according to the plane;
+     * explosions can be lit again with igniteCell() afterwards. Only the
+     * cells that change are written (and marked dirty).
+     * 
+     * @param blockWords Block plane in the layout of getBlockBits()
+     */
+    void restoreBlocks(const std::uint64_t* blockWords);
+    
+    /**
+     * @brief Get the cells whose type changed since the last clearDirtyCells()
+     * @return Padded buffer indices, each listed once
+     */
+    const std::vector<int>& getDirtyCells() const;
+    
+    /**
+     * @brief Forget the recorded cell changes
+     */
+    void clearDirtyCells();
+    
+    /**
+     * @brief Get the destructible block plane
+     * @return Bitboard with a bit per BLOCK cell
      */
-    void createExplosion(int x, int y, int range);
+    const Bitboard& getBlockBits() const;
     
     /**
-     * @brief Remove explosion effects from the map
+     * @brief Get the explosion plane
+     * @return Bitboard with a bit per EXPLOSION cell
      */
-    void clearExplosions();
+    const Bitboard& getExplosionBits() const;
     
     /**
      * @brief Initialize the map with walls and blocks
@@ -100,7 +233,43 @@ public:
 private:
     int width;                          ///< Map width
     int height;                         ///< Map height
-    std::vector<std::vector<CellType>> grid;  ///< 2D grid representing the map
+    int stride;                         ///< Padded row length (width + 2)
+    std::vector<CellType> cells;        ///< Row-major padded cell buffer
+    Bitboard blockBits;                 ///< BLOCK cells
+    Bitboard explosionBits;             ///< EXPLOSION cells
+    
+    /**
+     * @struct ExplosionTimer
+     * @brief Entry of the active explosion list
+     */
+    struct ExplosionTimer {
+        std::uint64_t expiryTick;       ///< Tick on which the cell goes out
+        int index;                      ///< Padded buffer index
+    };
+    
+    std::vector<std::uint64_t> explosionExpiry;   ///< Current expiry tick of each cell
+    std::vector<ExplosionTimer> activeExplosions; ///< Ignitions in expiry order
+    std::size_t activeHead;             ///< First unexpired entry of activeExplosions
+    std::vector<int> dirtyCells;        ///< Cells changed since the last clearDirtyCells()
+    std::vector<std::uint8_t> dirtyFlags; ///< Whether each cell is in dirtyCells
+    
+    /**
+     * @brief Write a cell and keep the bit planes in sync
+     * @param index Padded buffer index
+     * @param type CellType to set
+     */
+    void writeCell(int index, CellType type);
+    
+    /**
+     * @brief Record a cell change for incremental consumers such as the renderer
+     * @param index Padded buffer index
+     */
+    void markDirty(int index);
+    
+    /**
+     * @brief Rebuild every bit plane from the cell buffer
+     */
+    void rebuildBits();
     
     /**
      * @brief Check if a position should have a wall
@@ -111,5 +280,132 @@ private:
     bool shouldBeWall(int x, int y) const;
 };
 
+/**
+ * @brief Get the buffer index of a position
+ * @param x X coordinate in [-1, width]
+ * @param y Y coordinate in [-1, height]
+ * @return Index into the padded cell buffer
+ */
+inline int Map::getIndex(int x, int y) const {
+    return (y + 1) * stride + (x + 1);
+}
+
+/**
+ * @brief Get the cell type at a buffer index
+ * @param index Padded buffer index
+ * @return CellType at the index
+ */
+inline CellType Map::getCellAt(int index) const {
+    return cells[index];
+}
+
+/**
+ * @brief Set the cell type at a buffer index
+ * @param index Padded buffer index of a cell inside the map
+ * @param type CellType to set
+ */
+inline void Map::setCellAt(int index, CellType type) {
+    writeCell(index, type);
+}
+
+/**
+ * @brief Get the X coordinate of a buffer index
+ * @param index Padded buffer index
+ * @return X coordinate
+ */
+inline int Map::getIndexX(int index) const {
+    return index % stride - 1;
+}
+
+/**
+ * @brief Get the Y coordinate of a buffer index
+ * @param index Padded buffer index
+ * @return Y coordinate
+ */
+inline int Map::getIndexY(int index) const {
+    return index / stride - 1;
+}
+
+/**
+ * @brief Get the cell type without bounds checking
+ * @param x X coordinate in [-1, width]
+ * @param y Y coordinate in [-1, height]
+ * @return CellType at the position (WALL on the border)
+ */
+inline CellType Map::getCellUnchecked(int x, int y) const {
+    return cells[getIndex(x, y)];
+}
+
+/**
+ * @brief Set the cell type without bounds checking
+ * @param x X coordinate in [0, width)
+ * @param y Y coordinate in [0, height)
+ * @param type CellType to set
+ */
+inline void Map::setCellUnchecked(int x, int y, CellType type) {
+    writeCell(getIndex(x, y), type);
+}
+
+/**
+ * @brief Record a cell change for incremental consumers such as the renderer
+ * @param index Padded buffer index
+ */
+inline void Map::markDirty(int index) {
+    if (!dirtyFlags[index]) {
+        dirtyFlags[index] = 1;
+        dirtyCells.push_back(index);
+    }
+}
+
+/**
+ * @brief Write a cell and keep the bit planes in sync
+ * @param index Padded buffer index
+ * @param type CellType to set
+ */
+inline void Map::writeCell(int index, CellType type) {
+    if (cells[index] == type) {
+        return;
+    }
+    
+    markDirty(index);
+    
+    switch (cells[index]) {
+        case CellType::BLOCK:
+            blockBits.reset(index);
+            break;
+        case CellType::EXPLOSION:
+            explosionBits.reset(index);
+            break;
+        case CellType::EMPTY:
+        case CellType::WALL:
+            break;
+    }
+    
+    cells[index] = type;
+    
+    switch (type) {
+        case CellType::BLOCK:
+            blockBits.set(index);
+            break;
+        case CellType::EXPLOSION:
+            explosionBits.set(index);
+            break;
+        case CellType::EMPTY:
+        case CellType::WALL:
+            break;
+    }
+}
+
+/**
+ * @brief Check walkability without bounds checking
+ * @param x X coordinate in [-1, width]
+ * @param y Y coordinate in [-1, height]
+ * @return True if position is walkable
+ */
+inline bool Map::isWalkableUnchecked(int x, int y) const {
+    CellType cell = cells[getIndex(x, y)];
+    return cell == CellType::EMPTY || cell == CellType::EXPLOSION;
+}
+
 #endif // MAP_HPP
 
@@ -1,7 +1,7 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
-#include <SFML/Graphics.hpp>
+struct PlayerState;
 
 /**
  * @class Player
@@ -36,6 +36,23 @@ public:
      */
     int getY() const;
     
+    /**
+     * @brief Get the X position at the start of the current tick
+     * @return Previous X coordinate
+     */
+    int getPreviousX() const;
+    
+    /**
+     * @brief Get the Y position at the start of the current tick
+     * @return Previous Y coordinate
+     */
+    int getPreviousY() const;
+    
+    /**
+     * @brief Remember the current position as the previous one (start of a tick)
+     */
+    void storePreviousPosition();
+    
     /**
      * @brief Move the player up
      */
@@ -135,10 +152,24 @@ public:
      * @brief Increase bomb explosion range
      */
     void increaseBombRange();
+    
+    /**
+     * @brief Copy the player into a packed state
+     * @param state Output state
+     */
+    void saveState(PlayerState& state) const;
+    
+    /**
+     * @brief Overwrite the player with a packed state
+     * @param state Saved state
+     */
+    void restoreState(const PlayerState& state);
 
 private:
     int x;              ///< X coordinate on the map
     int y;              ///< Y coordinate on the map
+    int prevX;          ///< X coordinate at the start of the tick
+    int prevY;          ///< Y coordinate at the start of the tick
     int startX;         ///< Starting X position for respawn
     int startY;         ///< Starting Y position for respawn
     bool alive;         ///< Player's alive status
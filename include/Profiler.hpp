@@ -0,0 +1,174 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ProfileZone
+ * @brief Phases of a frame that can be timed
+ */
+enum class ProfileZone : std::uint8_t {
+    EVENTS,     ///< Window event polling
+    INPUT,      ///< Translating input into SimulationInput
+    UPDATE,     ///< Simulation::step
+    SNAPSHOT,   ///< Capturing and picking up snapshots
+    RENDER,     ///< Building and drawing the frame
+    DISPLAY     ///< window->display (buffer swap, vsync wait)
+};
+
+/// Number of ProfileZone values
+constexpr int PROFILE_ZONE_COUNT = 6;
+
+/**
+ * @struct FrameSample
+ * @brief Time spent in each zone during one frame
+ */
+struct FrameSample {
+    std::int64_t frameMicroseconds = 0;     ///< Wall time from one frame start to the next
+    std::array<std::int64_t, PROFILE_ZONE_COUNT> zoneMicroseconds = {}; ///< Time per zone
+};
+
+/**
+ * @class Profiler
+ * @brief Collects scoped zone timings into per-frame samples and a trace
+ *
+ * Zones are recorded from any thread. Each frame keeps the total time
+ * per zone in a ring of recent FrameSamples (for the in-game overlay),
+ * and every individual zone is appended to a ring of trace events that
+ * can be exported as Chrome trace-event JSON (chrome://tracing,
+ * Perfetto). Zones are only placed in code through PROFILE_ZONE, which
+ * compiles to nothing unless BOMBERMAN_PROFILING is defined.
+ */
+class Profiler {
+public:
+    static const std::size_t FRAME_HISTORY = 240;       ///< Frames kept for the overlay
+    static const std::size_t TRACE_CAPACITY = 65536;    ///< Zone events kept for export
+    
+    /**
+     * @brief Get the process-wide profiler
+     * @return Profiler instance
+     */
+    static Profiler& instance();
+    
+    /**
+     * @brief Get the current profiler time
+     * @return Microseconds since the profiler was created
+     */
+    std::int64_t now() const;
+    
+    /**
+     * @brief Close the current frame sample and start the next one
+     */
+    void beginFrame();
+    
+    /**
+     * @brief Record a finished zone
+     * @param zone Zone that was timed
+     * @param start Start time from now()
+     * @param end End time from now()
+     */
+    void record(ProfileZone zone, std::int64_t start, std::int64_t end);
+    
+    /**
+     * @brief Copy the recent frame samples, oldest first
+     * @param out Output samples
+     */
+    void getFrames(std::vector<FrameSample>& out) const;
+    
+    /**
+     * @brief Write the recorded zones as Chrome trace-event JSON
+     * @param path Output file
+     * @return True if the file was written
+     */
+    bool exportChromeTrace(const std::string& path) const;
+    
+    /**
+     * @brief Get the display name of a zone
+     * @param zone Zone
+     * @return Zone name
+     */
+    static const char* getZoneName(ProfileZone zone);
+
+private:
+    /**
+     * @struct TraceEvent
+     * @brief One recorded zone
+     */
+    struct TraceEvent {
+        std::int64_t start;         ///< Start time in microseconds
+        std::int64_t duration;      ///< Duration in microseconds
+        std::uint32_t thread;       ///< Small per-thread index
+        ProfileZone zone;           ///< Zone that was timed
+    };
+    
+    /**
+     * @brief Constructor for Profiler
+     */
+    Profiler();
+    
+    /**
+     * @brief Get a small index identifying the calling thread
+     * @return Thread index, starting at 1
+     */
+    static std::uint32_t getThreadIndex();
+    
+    std::chrono::steady_clock::time_point epoch;    ///< Time zero of now()
+    mutable std::mutex mutex;                       ///< Guards everything below
+    FrameSample current;                            ///< Frame being accumulated
+    std::int64_t frameStart;                        ///< Start of the current frame
+    std::array<FrameSample, FRAME_HISTORY> frames;  ///< Ring of finished frames
+    std::size_t frameCount;                         ///< Finished frames so far
+    std::vector<TraceEvent> trace;                  ///< Ring of zone events
+    std::size_t traceCount;                         ///< Zone events so far
+};
+
+/**
+ * @class ProfileScope
+ * @brief Times the enclosing scope as a zone
+ */
+class ProfileScope {
+public:
+    /**
+     * @brief Start timing a zone
+     * @param zone Zone to record
+     */
+    explicit ProfileScope(ProfileZone zone)
+        : zone(zone), start(Profiler::instance().now()) {
+    }
+    
+    /**
+     * @brief Record the zone
+     */
+    ~ProfileScope() {
+        Profiler& profiler = Profiler::instance();
+        profiler.record(zone, start, profiler.now());
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone;       ///< Zone being timed
+    std::int64_t start;     ///< Start time
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef BOMBERMAN_PROFILING
+/// Time the rest of the enclosing scope as the given zone
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfileZone::zone)
+/// Mark the start of a new frame
+#define PROFILE_FRAME() Profiler::instance().beginFrame()
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
+
+#endif // PROFILER_HPP
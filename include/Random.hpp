@@ -0,0 +1,130 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Random
+ * @brief Small, fast, seedable random number generator (xoshiro256**)
+ *
+ * Each Simulation owns its generators, so matches running side by side
+ * never share hidden state, and the same seed always gives the same
+ * numbers on every platform (unlike std::rand, whose algorithm and
+ * global state belong to the C library).
+ *
+ * A seed can be split into independent streams: stream k starts 2^128
+ * numbers after stream 0 of the same seed, so giving every subsystem its
+ * own stream keeps them from overlapping, and drawing more numbers in
+ * one subsystem does not shift the numbers another one sees.
+ */
+class Random {
+public:
+    /**
+     * @brief Constructor for Random
+     * @param seed Seed; any value, including 0, is fine
+     * @param stream Independent stream of the seed to use
+     */
+    explicit Random(std::uint64_t seed = 1, std::uint64_t stream = 0);
+
+    /**
+     * @brief Restart the generator from a seed
+     * @param seed Seed; any value, including 0, is fine
+     * @param stream Independent stream of the seed to use
+     */
+    void seed(std::uint64_t seed, std::uint64_t stream = 0);
+
+    /**
+     * @brief Get the next 64 random bits
+     * @return Uniformly distributed value
+     */
+    std::uint64_t next();
+
+    /**
+     * @brief Get a random integer below a bound, without modulo bias
+     * @param bound Exclusive upper bound, greater than 0
+     * @return Value in [0, bound)
+     */
+    std::uint32_t nextBelow(std::uint32_t bound);
+
+    /**
+     * @brief Return true with a given probability
+     * @param percent Probability in percent
+     * @return True in percent out of 100 calls on average
+     */
+    bool chance(int percent);
+
+    /**
+     * @brief Fill a buffer with random 64-bit values
+     * @param out Output values
+     * @param count Number of values
+     */
+    void fill(std::uint64_t* out, std::size_t count);
+
+    /**
+     * @brief Fill a buffer with random integers below a bound
+     * @param out Output values
+     * @param count Number of values
+     * @param bound Exclusive upper bound, greater than 0
+     */
+    void fillBelow(int* out, std::size_t count, std::uint32_t bound);
+
+private:
+    /**
+     * @brief Advance the state by 2^128 numbers
+     */
+    void jump();
+
+    std::uint64_t state[4];     ///< Generator state (never all zero)
+};
+
+/**
+ * @brief Get the next 64 random bits
+ * @return Uniformly distributed value
+ */
+inline std::uint64_t Random::next() {
+    std::uint64_t s1 = state[1];
+    std::uint64_t product = s1 * 5;
+    std::uint64_t result = ((product << 7) | (product >> 57)) * 9;
+    std::uint64_t t = s1 << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= s1;
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = (state[3] << 45) | (state[3] >> 19);
+
+    return result;
+}
+
+/**
+ * @brief Get a random integer below a bound, without modulo bias
+ * @param bound Exclusive upper bound, greater than 0
+ * @return Value in [0, bound)
+ */
+inline std::uint32_t Random::nextBelow(std::uint32_t bound) {
+    // Scale 32 random bits by the bound (Lemire); retry the few values
+    // that would make some results more likely than others
+    std::uint64_t scaled = (next() >> 32) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(scaled);
+    if (low < bound) {
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            scaled = (next() >> 32) * bound;
+            low = static_cast<std::uint32_t>(scaled);
+        }
+    }
+    return static_cast<std::uint32_t>(scaled >> 32);
+}
+
+/**
+ * @brief Return true with a given probability
+ * @param percent Probability in percent
+ * @return True in percent out of 100 calls on average
+ */
+inline bool Random::chance(int percent) {
+    return static_cast<int>(nextBelow(100)) < percent;
+}
+
+#endif // RANDOM_HPP
@@ -0,0 +1,488 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "Player.hpp"
+#include "Enemy.hpp"
+#include "Bomb.hpp"
+#include "BombPool.hpp"
+#include "BlastResolver.hpp"
+#include "ClusterGraph.hpp"
+#include "DangerMap.hpp"
+#include "EnemySearch.hpp"
+#include "FlowField.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "Map.hpp"
+#include "PowerUp.hpp"
+#include "Random.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
+
+struct GameState;
+
+/**
+ * @struct SimulationInput
+ * @brief Player commands applied during a single simulation step
+ */
+struct SimulationInput {
+    bool moveUp = false;        ///< Up movement held
+    bool moveDown = false;      ///< Down movement held
+    bool moveLeft = false;      ///< Left movement held
+    bool moveRight = false;     ///< Right movement held
+    bool placeBomb = false;     ///< Place a bomb at the player's position this step
+};
+
+/**
+ * @enum EnemyAi
+ * @brief How enemies decide what to do
+ */
+enum class EnemyAi {
+    STANDARD,           ///< Chase along the flow field, dodge fire, drop bombs at random
+    SEARCH              ///< Plan moves and bombs with a time-limited lookahead search
+};
+
+/**
+ * @struct SearchBudget
+ * @brief Limits of the SEARCH enemy AI
+ */
+struct SearchBudget {
+    int microseconds = 2000;    ///< Wall time per tick for all enemies together (0: no time limit)
+    int nodesPerEnemy = 4000;   ///< Search nodes per enemy decision
+};
+
+/**
+ * @enum SimulationEvent
+ * @brief Notable things that happened during a step (used by front ends for audio)
+ */
+enum class SimulationEvent {
+    BOMB_PLACED,        ///< Player placed a bomb
+    BOMB_EXPLODED,      ///< A bomb exploded
+    POWERUP_COLLECTED,  ///< Player collected a power-up
+    GAME_OVER,          ///< Player ran out of lives
+    YOU_WIN             ///< All enemies are dead
+};
+
+/// Number of SimulationEvent values
+constexpr int SIMULATION_EVENT_TYPES = 5;
+
+/**
+ * @class Simulation
+ * @brief Headless game logic for a single Bomberman match
+ * 
+ * This class owns the map, player, enemies, bombs and power-ups and
+ * advances them through step(), one fixed tick at a time. All timing is
+ * counted in whole ticks, so a match replays identically regardless of
+ * how fast step() is called. It has no dependency on SFML, so it can run
+ * without a window for batch matches, tools and AI training.
+ */
+class Simulation {
+public:
+    /**
+     * @brief Constructor for Simulation
+     * @param mapWidth Map width in cells
+     * @param mapHeight Map height in cells
+     * @param tickRate Simulation ticks per second
+     * @param enemyCount Number of enemies (three start in the corners,
+     *                   any others spread over the free cells)
+     * @param seed Seed of the random number generator; the same seed and
+     *             inputs always produce the same match
+     */
+    Simulation(int mapWidth = 21, int mapHeight = 15, int tickRate = 60, int enemyCount = 3,
+               std::uint32_t seed = 1);
+    
+    /**
+     * @brief Destructor
+     */
+    ~Simulation();
+    
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+    
+    /**
+     * @brief Advance the match by one tick
+     * @param input Player commands for this tick
+     */
+    void step(const SimulationInput& input);
+    
+    /**
+     * @brief Get the number of ticks simulated so far
+     * @return Current tick
+     */
+    std::uint64_t getTick() const;
+    
+    /**
+     * @brief Get the tick rate
+     * @return Simulation ticks per second
+     */
+    int getTickRate() const;
+    
+    /**
+     * @brief Get the seed the match was created with
+     * @return Random seed
+     */
+    std::uint32_t getSeed() const;
+    
+    /**
+     * @brief Get the game map
+     * 
+     * Map::getDirtyCells() lists the cells changed by the last step.
+     * 
+     * @return Map reference
+     */
+    const Map& getMap() const;
+    
+    /**
+     * @brief Get the player
+     * @return Player reference
+     */
+    const Player& getPlayer() const;
+    
+    /**
+     * @brief Get the enemies
+     * @return List of enemies
+     */
+    const std::vector<Enemy*>& getEnemies() const;
+    
+    /**
+     * @brief Get the active bombs
+     * @return Pool of bombs (iterable)
+     */
+    const BombPool& getBombs() const;
+    
+    /**
+     * @brief Get the power-ups on the map
+     * @return List of power-ups
+     */
+    const std::vector<PowerUp*>& getPowerUps() const;
+    
+    /**
+     * @brief Get the bomb at a position in O(1)
+     * @param x X coordinate in [-1, mapWidth]
+     * @param y Y coordinate in [-1, mapHeight]
+     * @return Bomb at the position, or nullptr if there is none
+     */
+    const Bomb* getBombAt(int x, int y) const;
+    
+    /**
+     * @brief Get the walking distance field towards the player
+     * 
+     * Brought up to date on the ticks enemies move.
+     * 
+     * @return Flow field
+     */
+    const FlowField& getFlowField() const;
+    
+    /**
+     * @brief Get the earliest tick fire reaches each cell
+     * 
+     * Always up to date with the active bombs, chains included.
+     * 
+     * @return Danger map
+     */
+    const DangerMap& getDangerMap() const;
+    
+    /**
+     * @brief Get the events produced by the last step
+     * @return List of events
+     */
+    const std::vector<SimulationEvent>& getEvents() const;
+    
+    /**
+     * @brief Get how many events of a type happened since the match started
+     * 
+     * Unlike getEvents(), the counts survive across steps, so a front end
+     * that only samples the simulation now and then can still tell which
+     * events happened in between.
+     * 
+     * @param event Event type
+     * @return Cumulative count
+     */
+    std::uint64_t getEventCount(SimulationEvent event) const;
+    
+    /**
+     * @brief Check if the match is lost
+     * @return True if the player has no lives left
+     */
+    bool isGameOver() const;
+    
+    /**
+     * @brief Check if the match is won
+     * @return True if all enemies are dead
+     */
+    bool isVictory() const;
+    
+    /**
+     * @brief Choose how enemies decide
+     * 
+     * With EnemyAi::SEARCH every enemy plans its moves and bombs with an
+     * EnemySearch. The enemies thinking on the same tick share the time
+     * budget evenly (time one does not use goes to the next), and an
+     * enemy whose share runs out before the search finishes a single
+     * level falls back to the standard AI for that move, so a tick never
+     * takes much longer than the budget. Without a time limit the match
+     * only depends on the seed, the input and the node limit; with one,
+     * it can also depend on how fast the machine is.
+     * 
+     * @param ai Enemy AI
+     * @param budget Limits of the search
+     */
+    void setEnemyAi(EnemyAi ai, const SearchBudget& budget = SearchBudget());
+    
+    /**
+     * @brief Get how enemies decide
+     * @return Enemy AI
+     */
+    EnemyAi getEnemyAi() const;
+    
+    /**
+     * @brief Get the limits of the SEARCH enemy AI
+     * @return Search budget
+     */
+    const SearchBudget& getSearchBudget() const;
+    
+    /**
+     * @brief Get how many search decisions fell back to the standard AI
+     * 
+     * That happens when the budget runs out before the first search level
+     * finishes, or when every move the search sees ends in fire.
+     * 
+     * @return Fallback count since the match started
+     */
+    std::uint64_t getSearchFallbacks() const;
+    
+    /**
+     * @brief Spread the enemy decisions over a number of threads
+     * 
+     * Enemies first decide from the state at the start of the tick, in
+     * parallel, and their moves are then applied one by one in enemy
+     * order. The match is the same for any thread count (with the search
+     * AI, as long as it has no time limit).
+     * 
+     * @param count Threads including the one calling step() (1: no pool)
+     */
+    void setWorkerThreads(int count);
+    
+    /**
+     * @brief Get the number of threads deciding for the enemies
+     * @return Thread count, the one calling step() included
+     */
+    int getWorkerThreads() const;
+    
+    /**
+     * @brief Pack the match into a GameState
+     * @param state Output state
+     * @return False if the match exceeds the GameState capacities
+     */
+    bool saveState(GameState& state) const;
+    
+    /**
+     * @brief Continue the match from a GameState
+     * 
+     * The state must come from a match with the same map size, enemy
+     * count and tick rate. After restoring, stepping with the same inputs
+     * produces the same ticks as the match the state was saved from.
+     * 
+     * @param state Saved state
+     * @return False if the state does not fit this match (nothing is changed)
+     */
+    bool restoreState(const GameState& state);
+
+private:
+    /**
+     * @brief Place a player bomb at the player's position
+     */
+    void placePlayerBomb();
+    
+    /**
+     * @brief Create the enemies
+     * @param count Number of enemies
+     */
+    void spawnEnemies(int count);
+    
+    /**
+     * @brief Record an event of the current step
+     * @param event Event to record
+     */
+    void emit(SimulationEvent event);
+    
+    /**
+     * @brief Decide phase for a range of enemies
+     * @param begin First enemy index
+     * @param end Enemy index past the last one
+     * @param worker Worker running the range
+     * @param enemiesMove Whether enemies move on this tick
+     * @param decisionSeed Seed of this tick's enemy decisions
+     */
+    void decideEnemies(std::size_t begin, std::size_t end, int worker,
+                       bool enemiesMove, std::uint64_t decisionSeed);
+    
+    /**
+     * @brief Choose an enemy's step with the standard AI
+     * @param enemy Enemy to move
+     * @param random Random generator of the enemy's decision
+     * @param pathfinder Path query scratch space of the calling worker
+     * @return Direction (0=up, 1=down, 2=left, 3=right), or -1 to stay
+     */
+    int chooseEnemyDirection(const Enemy& enemy, Random& random,
+                             HierarchicalPathfinder& pathfinder) const;
+    
+    /**
+     * @brief Check whether an enemy is beyond the flow field's reach
+     * @param enemy Enemy to check
+     * @return True on large maps if the field has no distance for the enemy
+     */
+    bool isRoaming(const Enemy& enemy) const;
+    
+    /**
+     * @brief Choose an enemy's action with the search AI
+     * @param enemy Enemy to move
+     * @param search Search scratch space of the calling worker
+     * @param deadline Time by which the search has to stop
+     * @param action Output, set only on success
+     * @return False if the budget did not allow a decision
+     */
+    bool searchEnemyAction(const Enemy& enemy, EnemySearch& search,
+                           std::chrono::steady_clock::time_point deadline,
+                           EnemyAction& action) const;
+    
+    /**
+     * @brief Add a bomb to the pool and the occupancy index
+     * @param bomb Bomb to add
+     */
+    void addBomb(const Bomb& bomb);
+    
+    /**
+     * @brief Check if a bomb occupies a position
+     * @param x X coordinate in [-1, mapWidth]
+     * @param y Y coordinate in [-1, mapHeight]
+     * @return True if a bomb is at the position
+     */
+    bool hasBombAt(int x, int y) const;
+    
+    /**
+     * @brief Apply player movement input
+     * @param input Player commands for this tick
+     */
+    void processInput(const SimulationInput& input);
+    
+    /**
+     * @brief Update enemies, bombs and collisions
+     */
+    void update();
+    
+    /**
+     * @brief Explode the bombs in bombsToRemove and every bomb they set off
+     */
+    void handleBombExplosions();
+    
+    /**
+     * @brief Check collisions between player and explosions
+     */
+    void checkPlayerCollisions();
+    
+    /**
+     * @brief Check collisions between enemies and explosions
+     */
+    void checkEnemyCollisions();
+    
+    /**
+     * @brief Handle player death and respawn
+     */
+    void handlePlayerDeath();
+    
+    /**
+     * @brief Check if all enemies are dead (victory condition)
+     */
+    void checkVictory();
+    
+    /**
+     * @brief Check collisions between player and power-ups
+     */
+    void checkPowerUpCollisions();
+    
+    /**
+     * @brief Spawn a power-up at a position (random chance)
+     * @param x X coordinate
+     * @param y Y coordinate
+     */
+    void spawnPowerUp(int x, int y);
+    
+    // Random streams of the match seed, one per subsystem
+    static const std::uint64_t ENEMY_AI_STREAM = 0;    ///< Enemy decisions and movement
+    static const std::uint64_t LOOT_STREAM = 1;        ///< Power-up drops
+    
+    static const int ENEMY_BOMB_RANGE = 2;             ///< Explosion range of enemy bombs
+    static const std::size_t DECIDE_CHUNK_SIZE = 32;   ///< Enemies per worker pool chunk
+    static const long HIERARCHY_MIN_CELLS = 256 * 256; ///< Map area from which enemies use the cluster graph
+    static const int CLUSTER_SIZE = 16;                ///< Cluster side of the cluster graph
+    static const std::uint32_t FLOW_FIELD_RADIUS = 64; ///< Reach of the flow field on such maps
+    
+    /**
+     * @struct EnemyDecision
+     * @brief What an enemy chose in the decide phase of a tick
+     */
+    struct EnemyDecision {
+        int direction;                  ///< Step to take, -1 to stay
+        bool placeBomb;                 ///< Drop a bomb on the cell left behind
+        bool fellBack;                  ///< Search gave up and the standard AI chose
+    };
+
+    Player* player;                     ///< Player object
+    std::vector<Enemy*> enemies;       ///< List of enemies
+    Map* map;                          ///< Game map
+    BombPool bombs;                    ///< Active bombs (one per cell at most)
+    TimerWheel fuseWheel;              ///< Detonation schedule, keyed by pool handle
+    std::vector<BombPool::Handle> bombsToRemove;  ///< Bombs to remove after update
+    std::vector<BombPool::Handle> bombGrid;       ///< Bomb per padded map index (INVALID_HANDLE if none)
+    BlastResolver blastResolver;       ///< Chain-reaction blast computation
+    BlastResult blast;                 ///< Result of the last blast resolution
+    FlowField flowField;               ///< Distance to the player, shared by all enemies
+    DangerMap dangerMap;               ///< Earliest tick fire reaches each cell
+    WorkerPool* workers;               ///< Threads for the decide phase (nullptr: run inline)
+    std::vector<EnemySearch> searches; ///< Search scratch space, one per worker
+    ClusterGraph clusterGraph;         ///< Entrance graph for long paths (large maps only)
+    std::vector<HierarchicalPathfinder> pathfinders; ///< Path query scratch space, one per worker
+    std::vector<EnemyDecision> enemyDecisions; ///< Decide phase output, one per enemy
+    std::vector<std::uint32_t> moveClaims; ///< Generation in which each cell was entered
+    std::uint32_t moveClaimGeneration; ///< Current enemy move
+    std::chrono::steady_clock::time_point thinkStart; ///< Start of this tick's search budget
+    std::atomic<int> thinkersLeft;     ///< Search enemies not yet started this tick
+    EnemyAi enemyAi;                   ///< How enemies decide
+    SearchBudget searchBudget;         ///< Limits of the SEARCH enemy AI
+    std::uint64_t searchFallbacks;     ///< Search decisions made by the standard AI instead
+    std::vector<PowerUp*> powerUps;    ///< List of power-ups on the map
+    std::vector<SimulationEvent> events; ///< Events produced by the last step
+    std::array<std::uint64_t, SIMULATION_EVENT_TYPES> eventCounts; ///< Events since the match started
+    
+    int mapWidth;                      ///< Map width in cells
+    int mapHeight;                     ///< Map height in cells
+    int tickRate;                      ///< Simulation ticks per second
+    std::uint32_t seed;                ///< Seed the match was created with
+    Random aiRandom;                   ///< Enemy AI random stream
+    Random lootRandom;                 ///< Power-up drop random stream
+    std::uint64_t tick;                ///< Ticks simulated so far
+    
+    bool gameOver;                     ///< Game over state
+    bool youWin;                       ///< Victory state
+    
+    // Durations in ticks (derived from tickRate)
+    int moveDelay;                     ///< Delay between player movements
+    int enemyMoveDelay;                ///< Delay between enemy movements
+    int enemyBombDelay;                ///< Delay between enemy bomb placements
+    int bombFuse;                      ///< Ticks before a bomb explodes
+    int explosionDuration;             ///< Ticks an explosion cell keeps burning
+    
+    // Tick counters
+    int moveTimer;                     ///< Ticks since last player movement
+    int enemyMoveTimer;                ///< Ticks since last enemy movement
+    
+    // Player starting position for respawn
+    int playerStartX;
+    int playerStartY;
+};
+
+#endif // SIMULATION_HPP
@@ -0,0 +1,126 @@
+#ifndef SOAK_RUNNER_HPP
+#define SOAK_RUNNER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "Random.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @struct SoakReport
+ * @brief Outcome of a soak run
+ */
+struct SoakReport {
+    std::uint64_t ticks = 0;            ///< Ticks simulated
+    std::uint64_t matches = 0;          ///< Matches started (a new one begins after each game over or victory)
+    std::uint64_t violations = 0;       ///< Invariant violations found
+    double stepSeconds = 0.0;           ///< Time spent inside Simulation::step
+    double totalSeconds = 0.0;          ///< Wall time of the whole run, checks included
+};
+
+/**
+ * @class SoakRunner
+ * @brief Runs the game logic headless for a long time with random input
+ *
+ * The runner plays matches back to back with a seeded random input
+ * stream, and after every tick checks invariants that must hold no
+ * matter what the player does:
+ * - no bomb owner has more bombs out plus in hand than its maximum, and
+ *   every bomb placed comes back to the one who placed it
+ * - no player, enemy or bomb sits on a WALL or BLOCK cell
+ * - the bomb grid agrees with the bomb pool, and no bomb is past its fuse
+ * - the incrementally updated danger map matches one stamped from scratch
+ *
+ * Matches alternate between the standard and the search enemy AI.
+ *
+ * The time spent in Simulation::step is measured separately from the
+ * checks, so the reported ticks per second track the simulation itself.
+ */
+class SoakRunner {
+public:
+    /**
+     * @brief Constructor for SoakRunner
+     * @param seed Seed of the random input stream
+     * @param mapWidth Map width in cells
+     * @param mapHeight Map height in cells
+     * @param enemyCount Number of enemies per match
+     */
+    SoakRunner(std::uint32_t seed, int mapWidth = 21, int mapHeight = 15, int enemyCount = 3);
+    
+    /**
+     * @brief Destructor
+     */
+    ~SoakRunner();
+    
+    SoakRunner(const SoakRunner&) = delete;
+    SoakRunner& operator=(const SoakRunner&) = delete;
+    
+    /**
+     * @brief Simulate a number of ticks, checking invariants after each
+     * @param ticks Ticks to simulate
+     * @param log Stream for progress lines and violations
+     * @return Summary of the run
+     */
+    SoakReport run(std::uint64_t ticks, std::ostream& log);
+
+private:
+    static const std::uint64_t MAX_LOGGED_VIOLATIONS = 20;  ///< Violations printed in full
+    static const std::uint64_t PROGRESS_INTERVAL = 1000000; ///< Ticks between progress lines
+    
+    /**
+     * @brief Start a new match
+     */
+    void restart();
+    
+    /**
+     * @brief Generate the input of the next tick
+     * @return Random player commands
+     */
+    SimulationInput nextInput();
+    
+    /**
+     * @brief Check every invariant on the current state
+     * @param log Stream for violations
+     */
+    void checkInvariants(std::ostream& log);
+    
+    /**
+     * @brief Check that a cell can hold an entity
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return True if the cell is inside the map and not a wall or block
+     */
+    bool isOpenCell(int x, int y) const;
+    
+    /**
+     * @brief Record an invariant violation
+     * @param log Stream for violations
+     * @param message Description of what went wrong
+     */
+    void fail(std::ostream& log, const char* message);
+    
+    int mapWidth;                   ///< Map width in cells
+    int mapHeight;                  ///< Map height in cells
+    int enemyCount;                 ///< Enemies per match
+    Simulation* simulation;         ///< Match being played
+    Random random;                  ///< Random input stream (also seeds each match)
+    std::uint32_t matchSeed;        ///< Seed of the match being played
+    SimulationInput held;           ///< Movement currently held down
+    int holdTicks;                  ///< Ticks left before choosing a new movement
+    std::vector<int> bombsOut;      ///< Bombs on the map per owner (player first, then enemies)
+    std::vector<BombPool::Handle> bombGrid; ///< Bomb handle per padded map index, rebuilt for the check
+    DangerMap expectedDanger;       ///< Danger map stamped from scratch for the check
+    SoakReport report;              ///< Results so far
+};
+
+/**
+ * @brief Run the soak test from command line arguments and print a summary
+ * @param argc Number of arguments
+ * @param argv Arguments: [ticks] [seed]
+ * @param out Stream for progress, violations and the summary
+ * @return Exit code (0 if no invariant was violated)
+ */
+int runSoakTest(int argc, char* argv[], std::ostream& out);
+
+#endif // SOAK_RUNNER_HPP
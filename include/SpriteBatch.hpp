@@ -0,0 +1,66 @@
+#ifndef SPRITE_BATCH_HPP
+#define SPRITE_BATCH_HPP
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @enum SpriteShape
+ * @brief Regions of the sprite atlas
+ */
+enum class SpriteShape {
+    CIRCLE,     ///< Filled disc (player, enemies, bombs)
+    SQUARE      ///< Filled square (power-ups)
+};
+
+/**
+ * @class SpriteBatch
+ * @brief Collects the dynamic entities of a frame into one vertex buffer
+ *
+ * Every sprite is a textured quad (two triangles) sampling a white shape
+ * from a small atlas generated at startup and tinted through the vertex
+ * color. The whole batch shares the atlas texture, so any number of
+ * entities is drawn with a single draw call. The vertex array keeps its
+ * capacity between frames, so refilling it does not allocate.
+ */
+class SpriteBatch : public sf::Drawable {
+public:
+    /**
+     * @brief Constructor for SpriteBatch
+     */
+    SpriteBatch();
+    
+    /**
+     * @brief Generate the atlas texture
+     * @return True if the texture was created
+     */
+    bool initialize();
+    
+    /**
+     * @brief Remove every sprite from the batch
+     */
+    void clear();
+    
+    /**
+     * @brief Add a sprite to the batch
+     * @param shape Atlas region to draw
+     * @param position Screen position of the top-left corner
+     * @param size Size of the sprite in pixels
+     * @param color Tint color
+     */
+    void add(SpriteShape shape, sf::Vector2f position, sf::Vector2f size, sf::Color color);
+
+private:
+    /**
+     * @brief Draw every sprite of the batch in a single call
+     * @param target Render target
+     * @param states Render states
+     */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    
+    static const unsigned int REGION_SIZE = 64;     ///< Atlas region side in pixels
+    
+    sf::Texture atlas;          ///< One white shape per SpriteShape, side by side
+    sf::VertexArray vertices;   ///< Six vertices per sprite
+};
+
+#endif // SPRITE_BATCH_HPP
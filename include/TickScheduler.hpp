@@ -0,0 +1,73 @@
+#ifndef TICK_SCHEDULER_HPP
+#define TICK_SCHEDULER_HPP
+
+#include <cstdint>
+
+/**
+ * @class TickScheduler
+ * @brief Converts real elapsed time into a whole number of fixed simulation ticks
+ * 
+ * The front end feeds the wall-clock time of each frame and runs as many
+ * simulation ticks as have become due. The simulation itself only ever
+ * sees whole ticks, so its results do not depend on the render rate.
+ */
+class TickScheduler {
+public:
+    /**
+     * @brief Constructor for TickScheduler
+     * @param tickRate Simulation ticks per second
+     * @param maxTicksPerAdvance Upper bound of ticks returned by one advance() call
+     */
+    TickScheduler(int tickRate = 60, int maxTicksPerAdvance = 8);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TickScheduler();
+    
+    /**
+     * @brief Get the tick rate
+     * @return Simulation ticks per second
+     */
+    int getTickRate() const;
+    
+    /**
+     * @brief Get the duration of a single tick
+     * @return Tick duration in microseconds
+     */
+    std::int64_t getTickMicroseconds() const;
+    
+    /**
+     * @brief Get the real time left before the next tick becomes due
+     * @return Time in microseconds
+     */
+    std::int64_t getMicrosecondsUntilNextTick() const;
+    
+    /**
+     * @brief Accumulate elapsed real time
+     * @param elapsedMicroseconds Real time elapsed since the last call
+     * @return Number of ticks that should be simulated now
+     */
+    int advance(std::int64_t elapsedMicroseconds);
+    
+    /**
+     * @brief Drop any accumulated time
+     */
+    void reset();
+    
+    /**
+     * @brief Convert a duration in seconds to ticks
+     * @param seconds Duration in seconds
+     * @param tickRate Simulation ticks per second
+     * @return Duration in ticks (at least one tick)
+     */
+    static int secondsToTicks(float seconds, int tickRate);
+
+private:
+    int tickRate;                       ///< Simulation ticks per second
+    int maxTicksPerAdvance;             ///< Cap that prevents a slow frame from snowballing
+    std::int64_t tickMicroseconds;      ///< Duration of a tick in microseconds
+    std::int64_t accumulator;           ///< Real time not yet consumed by ticks
+};
+
+#endif // TICK_SCHEDULER_HPP
@@ -0,0 +1,69 @@
+#ifndef TILE_MAP_RENDERER_HPP
+#define TILE_MAP_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "GameSnapshot.hpp"
+
+/**
+ * @class TileMapRenderer
+ * @brief Draws the map from a single cached vertex array
+ *
+ * Every cell owns one quad (two triangles) in a persistent
+ * sf::VertexArray built once per map. When the next snapshot arrives
+ * only the quads of its changedCells are recolored; the whole map is
+ * drawn with one draw call, so the per-frame cost no longer grows with
+ * the number of cells. If the main thread missed snapshots in between,
+ * their change lists are gone, so the cells are compared byte by byte
+ * with the ones already drawn instead.
+ */
+class TileMapRenderer : public sf::Drawable {
+public:
+    /**
+     * @brief Constructor for TileMapRenderer
+     */
+    TileMapRenderer();
+    
+    /**
+     * @brief Build the vertex array for every cell of a snapshot
+     * @param snapshot Snapshot to draw
+     * @param cellSize Size of each cell in pixels
+     * @param origin Screen position of the top-left cell
+     */
+    void build(const GameSnapshot& snapshot, int cellSize, sf::Vector2f origin);
+    
+    /**
+     * @brief Recolor the cells that differ from the last drawn snapshot
+     * @param snapshot Newer snapshot of the map passed to build()
+     */
+    void update(const GameSnapshot& snapshot);
+
+private:
+    /**
+     * @brief Draw the map in a single call
+     * @param target Render target
+     * @param states Render states
+     */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    
+    /**
+     * @brief Write the color of one cell into its quad
+     * @param cell Cell index (row-major, without border)
+     * @param type Cell type
+     */
+    void setCellColor(int cell, CellType type);
+    
+    /**
+     * @brief Get the fill color of a cell type
+     * @param type Cell type
+     * @return Colour of the cell
+     */
+    static sf::Color getCellColor(CellType type);
+    
+    sf::VertexArray vertices;   ///< Six vertices per cell
+    std::vector<CellType> cells;    ///< Cells currently in the vertex array
+    std::uint64_t sequence;     ///< Sequence number of the drawn snapshot
+};
+
+#endif // TILE_MAP_RENDERER_HPP
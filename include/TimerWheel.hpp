@@ -0,0 +1,107 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timer wheel that fires handles on the tick they are due
+ * 
+ * Each timer is hashed into slot (tick % slotCount) and linked into that
+ * slot's intrusive doubly-linked list. Firing a tick only walks a single
+ * slot, so the per-tick cost depends on the timers due (plus the rare
+ * timer more than one revolution away), not on how many are pending.
+ * Cancelling is O(1). Storage is sized once for a fixed number of handles.
+ */
+class TimerWheel {
+public:
+    /**
+     * @brief Handle identifying a timer (e.g. a BombPool handle)
+     */
+    using Handle = std::uint32_t;
+    
+    /**
+     * @brief Constructor for TimerWheel
+     * @param slotCount Number of slots (rounded up to a power of two)
+     * @param capacity Number of distinct handles, [0, capacity)
+     */
+    TimerWheel(std::size_t slotCount = 256, std::size_t capacity = 0);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TimerWheel();
+    
+    /**
+     * @brief Drop all timers and resize the wheel
+     * @param slotCount Number of slots (rounded up to a power of two)
+     * @param capacity Number of distinct handles, [0, capacity)
+     */
+    void reset(std::size_t slotCount, std::size_t capacity);
+    
+    /**
+     * @brief Schedule a handle to fire on a tick
+     * @param handle Handle that is not currently scheduled
+     * @param tick Tick on which the handle becomes due
+     */
+    void schedule(Handle handle, std::uint64_t tick);
+    
+    /**
+     * @brief Remove a scheduled handle before it fires
+     * @param handle Handle to cancel (ignored if not scheduled)
+     */
+    void cancel(Handle handle);
+    
+    /**
+     * @brief Check if a handle is scheduled
+     * @param handle Handle to check
+     * @return True if the handle is pending
+     */
+    bool isScheduled(Handle handle) const;
+    
+    /**
+     * @brief Get the tick a handle is scheduled for
+     * @param handle Scheduled handle
+     * @return Due tick
+     */
+    std::uint64_t getDeadline(Handle handle) const;
+    
+    /**
+     * @brief Unschedule and collect every handle due on or before a tick
+     * 
+     * Must be called for every tick in order; the wheel only inspects the
+     * slot that @p tick hashes to.
+     * 
+     * @param tick Current tick
+     * @param due Output list; due handles are appended in scheduling order
+     */
+    void collectDue(std::uint64_t tick, std::vector<Handle>& due);
+    
+    /**
+     * @brief Get the number of pending timers
+     * @return Pending timer count
+     */
+    std::size_t size() const;
+
+private:
+    static constexpr Handle NONE = 0xFFFFFFFFu;  ///< End of list / unscheduled
+    
+    std::vector<Handle> heads;          ///< First handle of each slot
+    std::vector<Handle> tails;          ///< Last handle of each slot
+    std::vector<Handle> next;           ///< Next handle in the same slot
+    std::vector<Handle> prev;           ///< Previous handle in the same slot
+    std::vector<std::uint64_t> deadlines; ///< Due tick of each handle
+    std::vector<bool> scheduled;        ///< Whether each handle is pending
+    std::size_t mask;                   ///< slotCount - 1
+    std::size_t pending;                ///< Number of pending timers
+    
+    /**
+     * @brief Unlink a handle from its slot list
+     * @param handle Scheduled handle
+     */
+    void unlink(Handle handle);
+};
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,82 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Lock-free single-producer/single-consumer hand-off of the latest value
+ *
+ * Three slots rotate between the writer (back), the reader (front) and a
+ * shared middle slot. The writer fills its back slot and publishes it by
+ * swapping it with the middle one; the reader swaps the middle slot into
+ * the front when a new value is waiting. Neither side ever blocks or
+ * waits for the other, and each always owns a slot exclusively, so the
+ * reader sees whole values only. Intermediate values the reader was too
+ * slow to pick up are overwritten.
+ *
+ * @tparam T Stored value, reused in place to avoid reallocation
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Constructor for TripleBuffer
+     */
+    TripleBuffer() : middle(1), back(0), front(2) {
+    }
+    
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    
+    /**
+     * @brief Get the slot the writer fills next (writer thread only)
+     * @return Back slot
+     */
+    T& writeBuffer() {
+        return slots[back];
+    }
+    
+    /**
+     * @brief Make the back slot the latest value (writer thread only)
+     */
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(back | FRESH),
+                                                std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+    
+    /**
+     * @brief Pick up the latest published value (reader thread only)
+     * @return True if a new value was published since the last call
+     */
+    bool update() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        
+        std::uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    
+    /**
+     * @brief Get the value picked up by the last update() (reader thread only)
+     * @return Front slot
+     */
+    const T& read() const {
+        return slots[front];
+    }
+
+private:
+    static const std::uint8_t INDEX_MASK = 0x3;    ///< Slot index bits of middle
+    static const std::uint8_t FRESH = 0x4;         ///< Middle holds an unread value
+    
+    T slots[3];                         ///< Back, middle and front values
+    std::atomic<std::uint8_t> middle;   ///< Shared slot index and FRESH flag
+    std::uint8_t back;                  ///< Slot owned by the writer
+    std::uint8_t front;                 ///< Slot owned by the reader
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -0,0 +1,87 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of threads that split loops over an index range
+ *
+ * run() cuts the range [0, count) into chunks of a given size, and the
+ * calling thread and the pool threads take chunks until none are left;
+ * run() returns once every chunk is done. Each call gets the worker
+ * number, so tasks can keep per-worker scratch space without locking.
+ *
+ * Which worker gets which chunk changes from run to run. Tasks that
+ * must give reproducible results should write only to slots owned by
+ * their indices and read nothing another chunk writes.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Loop body: handles indices [begin, end) as the given worker
+     */
+    using Task = std::function<void(std::size_t begin, std::size_t end, int worker)>;
+    
+    /**
+     * @brief Constructor for WorkerPool
+     * @param workerCount Workers including the calling thread (at least 1)
+     */
+    explicit WorkerPool(int workerCount);
+    
+    /**
+     * @brief Destructor (stops and joins the threads)
+     */
+    ~WorkerPool();
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    /**
+     * @brief Get the number of workers, the calling thread included
+     * @return Worker count
+     */
+    int getWorkerCount() const;
+    
+    /**
+     * @brief Run a task over [0, count) and wait for it to finish
+     * @param count Number of indices
+     * @param chunkSize Indices per chunk (at least 1)
+     * @param task Loop body
+     */
+    void run(std::size_t count, std::size_t chunkSize, const Task& task);
+
+private:
+    /**
+     * @brief Body of a pool thread
+     * @param worker Worker number
+     */
+    void workerLoop(int worker);
+    
+    /**
+     * @brief Take chunks of the current run until none are left
+     * @param worker Worker number
+     */
+    void drain(int worker);
+    
+    std::vector<std::thread> threads;   ///< Pool threads (workers 1 and up)
+    std::mutex mutex;                   ///< Guards the fields below
+    std::condition_variable wake;       ///< Signals a new run or shutdown
+    std::condition_variable finished;   ///< Signals the last thread leaving a run
+    const Task* task;                   ///< Task of the current run
+    std::size_t count;                  ///< Indices of the current run
+    std::size_t chunkSize;              ///< Chunk size of the current run
+    std::atomic<std::size_t> next;      ///< First index not yet taken
+    int busy;                           ///< Pool threads still in the current run
+    std::uint64_t generation;           ///< Number of runs started
+    bool stopping;                      ///< Set when the pool shuts down
+};
+
+#endif // WORKER_POOL_HPP
@@ -0,0 +1,20 @@
+#include "../include/SoakRunner.hpp"
+#include <iostream>
+
+/**
+ * @file SoakMain.cpp
+ * @brief Headless soak test (make soak), linked only against the
+ * simulation library so it runs on machines without SFML or a display
+ * 
+ * Usage: bomberman_soak [ticks] [seed]
+ */
+
+/**
+ * @brief Run the soak test
+ * @param argc Argument count
+ * @param argv Arguments (argv[1]: ticks, argv[2]: seed)
+ * @return Exit code (0 if no invariant was violated)
+ */
+int main(int argc, char* argv[]) {
+    return runSoakTest(argc - 1, argv + 1, std::cout);
+}
@@ -0,0 +1,64 @@
+#include "../include/Bitboard.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for Bitboard
+ * @param bitCount Number of bits (all cleared)
+ */
+Bitboard::Bitboard(std::size_t bitCount)
+    : bitCount(bitCount), words((bitCount + 63) / 64, 0) {
+}
+
+/**
+ * @brief Destructor
+ */
+Bitboard::~Bitboard() {
+}
+
+/**
+ * @brief Change the number of bits and clear them all
+ * @param bitCount Number of bits
+ */
+void Bitboard::resize(std::size_t bitCount) {
+    this->bitCount = bitCount;
+    words.assign((bitCount + 63) / 64, 0);
+}
+
+/**
+ * @brief Get the number of bits
+ * @return Bit count
+ */
+std::size_t Bitboard::size() const {
+    return bitCount;
+}
+
+/**
+ * @brief Get the number of 64-bit words
+ * @return Word count
+ */
+std::size_t Bitboard::wordCount() const {
+    return words.size();
+}
+
+/**
+ * @brief Access the underlying words
+ * @return Pointer to the first word
+ */
+const std::uint64_t* Bitboard::data() const {
+    return words.data();
+}
+
+/**
+ * @brief Access the underlying words
+ * @return Pointer to the first word
+ */
+std::uint64_t* Bitboard::data() {
+    return words.data();
+}
+
+/**
+ * @brief Clear all bits
+ */
+void Bitboard::clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
@@ -0,0 +1,132 @@
+#include "../include/BlastResolver.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for BlastResolver
+ */
+BlastResolver::BlastResolver() : generation(0) {
+}
+
+/**
+ * @brief Destructor
+ */
+BlastResolver::~BlastResolver() {
+}
+
+/**
+ * @brief Size the internal buffers (done once per map)
+ * @param cellCount Number of cells in the padded map buffer
+ * @param bombCapacity Capacity of the bomb pool
+ */
+void BlastResolver::reset(std::size_t cellCount, std::size_t bombCapacity) {
+    cellStamps.assign(cellCount, 0);
+    bombStamps.assign(bombCapacity, 0);
+    generation = 0;
+}
+
+/**
+ * @brief Resolve a chain of explosions
+ * @param map Game map (read only)
+ * @param bombs Active bombs (read only)
+ * @param bombGrid Bomb handle per padded map index
+ * @param triggers Bombs whose fuse ran out this tick
+ * @param result Output, cleared first
+ */
+void BlastResolver::resolve(const Map& map,
+                            const BombPool& bombs,
+                            const std::vector<BombPool::Handle>& bombGrid,
+                            const std::vector<BombPool::Handle>& triggers,
+                            BlastResult& result) {
+    result.cells.clear();
+    result.destroyedBlocks.clear();
+    result.detonated.clear();
+    
+    // Stamps from earlier calls become stale by bumping the generation;
+    // only on wrap-around do the arrays need clearing
+    if (++generation == 0) {
+        std::fill(cellStamps.begin(), cellStamps.end(), 0);
+        std::fill(bombStamps.begin(), bombStamps.end(), 0);
+        generation = 1;
+    }
+    
+    for (BombPool::Handle handle : triggers) {
+        enqueue(handle, result);
+    }
+    
+    const int stride = map.getStride();
+    const int offsets[4] = {-stride, stride, -1, 1};
+    
+    // detonated doubles as the worklist: bombs reached by a blast are
+    // appended and processed by this same loop
+    for (std::size_t next = 0; next < result.detonated.size(); next++) {
+        const Bomb& bomb = bombs.get(result.detonated[next]);
+        const int center = map.getIndex(bomb.getX(), bomb.getY());
+        const int range = bomb.getExplosionRange();
+        
+        // Center explosion
+        burn(center, map.getCellAt(center), bombGrid, result);
+        
+        // Explosion in four directions; the wall border ends every ray
+        for (int dir = 0; dir < 4; dir++) {
+            int index = center;
+            for (int r = 1; r <= range; r++) {
+                index += offsets[dir];
+                CellType cell = map.getCellAt(index);
+                
+                // Stop explosion at walls
+                if (cell == CellType::WALL) {
+                    break;
+                }
+                
+                burn(index, cell, bombGrid, result);
+                
+                // Stop explosion after reaching a block
+                if (cell == CellType::BLOCK) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Record a cell reached by fire
+ * @param index Padded map index
+ * @param cell Cell type at that index
+ * @param bombGrid Bomb handle per padded map index
+ * @param result Result being built
+ */
+void BlastResolver::burn(int index, CellType cell,
+                         const std::vector<BombPool::Handle>& bombGrid,
+                         BlastResult& result) {
+    if (cell == CellType::WALL || cellStamps[index] == generation) {
+        return;
+    }
+    cellStamps[index] = generation;
+    
+    if (cell == CellType::BLOCK) {
+        result.destroyedBlocks.push_back(index);
+        return;
+    }
+    
+    result.cells.push_back(index);
+    
+    // Set off any bomb caught in the blast
+    BombPool::Handle handle = bombGrid[index];
+    if (handle != BombPool::INVALID_HANDLE) {
+        enqueue(handle, result);
+    }
+}
+
+/**
+ * @brief Queue a bomb for detonation unless it already is
+ * @param handle Bomb handle
+ * @param result Result being built
+ */
+void BlastResolver::enqueue(BombPool::Handle handle, BlastResult& result) {
+    if (bombStamps[handle] == generation) {
+        return;
+    }
+    bombStamps[handle] = generation;
+    result.detonated.push_back(handle);
+}
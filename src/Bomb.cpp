@@ -5,20 +5,16 @@
  * @param x X position of the bomb on the map
  * @param y Y position of the bomb on the map
  * @param owner Type of owner (player or enemy)
- * @param fuseTime Time in seconds before explosion
+ * @param detonationTick Simulation tick on which the bomb explodes
  * @param explosionRange Range of the explosion
+ * @param ownerIndex Index of the owning enemy (ignored for the player)
  */
-Bomb::Bomb(int x, int y, OwnerType owner, float fuseTime, int explosionRange)
-    : x(x), y(y), owner(owner), fuseTime(fuseTime), elapsedTime(0.0f), 
+Bomb::Bomb(int x, int y, OwnerType owner, std::uint64_t detonationTick, int explosionRange,
+           int ownerIndex)
+    : x(x), y(y), owner(owner), ownerIndex(ownerIndex), detonationTick(detonationTick), 
       exploded(false), explosionRange(explosionRange) {
 }
 
-/**
- * @brief Destructor
- */
-Bomb::~Bomb() {
-}
-
 /**
  * @brief Get the X position of the bomb
  * @return X coordinate
@@ -36,23 +32,10 @@ int Bomb::getY() const {
 }
 
 /**
- * @brief Update the bomb state
- * @param deltaTime Time elapsed since last update
- * @return True if bomb has exploded, false otherwise
+ * @brief Mark the bomb as exploded
  */
-bool Bomb::update(float deltaTime) {
-    if (exploded) {
-        return true;
-    }
-    
-    elapsedTime += deltaTime;
-    
-    if (elapsedTime >= fuseTime) {
-        exploded = true;
-        return true;
-    }
-    
-    return false;
+void Bomb::explode() {
+    exploded = true;
 }
 
 /**
@@ -71,12 +54,24 @@ int Bomb::getExplosionRange() const {
     return explosionRange;
 }
 
+/**
+ * @brief Get the tick on which the bomb explodes
+ * @return Detonation tick
+ */
+std::uint64_t Bomb::getDetonationTick() const {
+    return detonationTick;
+}
+
 /**
  * @brief Get remaining fuse time
- * @return Remaining time before explosion
+ * @param currentTick Current simulation tick
+ * @return Remaining ticks before explosion (0 once due)
  */
-float Bomb::getRemainingTime() const {
-    return fuseTime - elapsedTime;
+int Bomb::getRemainingTicks(std::uint64_t currentTick) const {
+    if (currentTick >= detonationTick) {
+        return 0;
+    }
+    return static_cast<int>(detonationTick - currentTick);
 }
 
 /**
@@ -87,3 +82,11 @@ Bomb::OwnerType Bomb::getOwner() const {
     return owner;
 }
 
+
+/**
+ * @brief Get the index of the enemy that placed the bomb
+ * @return Index into Simulation::getEnemies() (0 for player bombs)
+ */
+int Bomb::getOwnerIndex() const {
+    return ownerIndex;
+}
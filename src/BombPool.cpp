@@ -0,0 +1,166 @@
+#include "../include/BombPool.hpp"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Bomb>::value,
+              "Bomb must stay a plain record so the pool can move it freely");
+
+/**
+ * @brief Constructor for BombPool
+ * @param capacity Maximum number of simultaneous bombs
+ */
+BombPool::BombPool(std::size_t capacity) {
+    reset(capacity);
+}
+
+/**
+ * @brief Destructor
+ */
+BombPool::~BombPool() {
+}
+
+/**
+ * @brief Drop all bombs and change the capacity
+ * @param capacity Maximum number of simultaneous bombs
+ */
+void BombPool::reset(std::size_t capacity) {
+    bombs.clear();
+    bombs.reserve(capacity);
+    handles.clear();
+    handles.reserve(capacity);
+    slots.assign(capacity, 0);
+    freeHandles.clear();
+    freeHandles.reserve(capacity);
+    
+    // Hand out low handles first
+    for (std::size_t i = capacity; i > 0; i--) {
+        freeHandles.push_back(static_cast<Handle>(i - 1));
+    }
+}
+
+/**
+ * @brief Get the maximum number of simultaneous bombs
+ * @return Capacity
+ */
+std::size_t BombPool::capacity() const {
+    return slots.size();
+}
+
+/**
+ * @brief Get the number of active bombs
+ * @return Active bomb count
+ */
+std::size_t BombPool::size() const {
+    return bombs.size();
+}
+
+/**
+ * @brief Check if there are no active bombs
+ * @return True if the pool is empty
+ */
+bool BombPool::empty() const {
+    return bombs.empty();
+}
+
+/**
+ * @brief Add a bomb
+ * @param bomb Bomb to copy into the pool
+ * @return Handle of the new bomb, or INVALID_HANDLE if the pool is full
+ */
+BombPool::Handle BombPool::add(const Bomb& bomb) {
+    if (freeHandles.empty()) {
+        return INVALID_HANDLE;
+    }
+    
+    Handle handle = freeHandles.back();
+    freeHandles.pop_back();
+    
+    slots[handle] = static_cast<std::uint32_t>(bombs.size());
+    bombs.push_back(bomb);
+    handles.push_back(handle);
+    return handle;
+}
+
+/**
+ * @brief Remove a bomb (the last bomb moves into its slot)
+ * @param handle Handle of the bomb to remove
+ */
+void BombPool::remove(Handle handle) {
+    std::uint32_t slot = slots[handle];
+    std::uint32_t last = static_cast<std::uint32_t>(bombs.size() - 1);
+    
+    if (slot != last) {
+        bombs[slot] = bombs[last];
+        handles[slot] = handles[last];
+        slots[handles[slot]] = slot;
+    }
+    
+    bombs.pop_back();
+    handles.pop_back();
+    freeHandles.push_back(handle);
+}
+
+/**
+ * @brief Access a bomb by handle
+ * @param handle Handle of an active bomb
+ * @return Bomb reference (valid until the next add/remove)
+ */
+Bomb& BombPool::get(Handle handle) {
+    return bombs[slots[handle]];
+}
+
+/**
+ * @brief Access a bomb by handle
+ * @param handle Handle of an active bomb
+ * @return Bomb reference (valid until the next add/remove)
+ */
+const Bomb& BombPool::get(Handle handle) const {
+    return bombs[slots[handle]];
+}
+
+/**
+ * @brief Get the handle of the bomb at a position in the dense array
+ * @param index Position in [0, size())
+ * @return Handle of that bomb
+ */
+BombPool::Handle BombPool::handleAt(std::size_t index) const {
+    return handles[index];
+}
+
+/**
+ * @brief Remove every bomb
+ */
+void BombPool::clear() {
+    reset(capacity());
+}
+
+/**
+ * @brief Iterate the active bombs
+ * @return Pointer to the first active bomb
+ */
+Bomb* BombPool::begin() {
+    return bombs.data();
+}
+
+/**
+ * @brief Iterate the active bombs
+ * @return Pointer past the last active bomb
+ */
+Bomb* BombPool::end() {
+    return bombs.data() + bombs.size();
+}
+
+/**
+ * @brief Iterate the active bombs
+ * @return Pointer to the first active bomb
+ */
+const Bomb* BombPool::begin() const {
+    return bombs.data();
+}
+
+/**
+ * @brief Iterate the active bombs
+ * @return Pointer past the last active bomb
+ */
+const Bomb* BombPool::end() const {
+    return bombs.data() + bombs.size();
+}
@@ -0,0 +1,472 @@
+#include "../include/ClusterGraph.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for ClusterGraph (empty until built)
+ */
+ClusterGraph::ClusterGraph()
+    : width(0), height(0), stride(0), clusterSize(0), clustersX(0), clustersY(0), rebuildCount(0) {
+}
+
+/**
+ * @brief Build the whole graph for a map
+ * @param map Map to cover
+ * @param clusterSize Cluster side in cells (clamped to the limits above)
+ */
+void ClusterGraph::build(const Map& map, int clusterSize) {
+    width = map.getWidth();
+    height = map.getHeight();
+    stride = map.getStride();
+    this->clusterSize = std::max(MIN_CLUSTER_SIZE, std::min(clusterSize, MAX_CLUSTER_SIZE));
+    clustersX = (width + this->clusterSize - 1) / this->clusterSize;
+    clustersY = (height + this->clusterSize - 1) / this->clusterSize;
+    
+    const std::size_t clusterCount = static_cast<std::size_t>(clustersX) * clustersY;
+    clusters.assign(clusterCount, Cluster());
+    nodes.clear();
+    freeNodes.clear();
+    borderNodes.assign(clusterCount * 2, std::vector<int>());
+    borderDirty.assign(clusterCount * 2, false);
+    dirtyBorders.clear();
+    dirtyClusters.clear();
+    distances.assign(static_cast<std::size_t>(this->clusterSize) * this->clusterSize, NO_PATH);
+    changedCells.clear();
+    queue.reserve(distances.size());
+    
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            int cluster = cy * clustersX + cx;
+            if (cx + 1 < clustersX) {
+                markBorder(cluster);
+            }
+            if (cy + 1 < clustersY) {
+                markBorder(static_cast<int>(clusterCount) + cluster);
+            }
+            markCluster(cluster);
+        }
+    }
+    update(map);
+    connectAll(map);
+}
+
+/**
+ * @brief Report a cell that became walkable or blocked
+ * @param index Padded map index
+ */
+void ClusterGraph::markCellChanged(int index) {
+    if (!isBuilt()) {
+        return;
+    }
+    
+    int x = index % stride - 1;
+    int y = index / stride - 1;
+    int cx = x / clusterSize;
+    int cy = y / clusterSize;
+    int cluster = cy * clustersX + cx;
+    int horizontal = clustersX * clustersY;
+    markCluster(cluster);
+    changedCells.push_back(index);
+    
+    // A cell on the edge of its cluster can open or close an entrance
+    if (x % clusterSize == 0 && cx > 0) {
+        markBorder(cluster - 1);
+    }
+    if (x % clusterSize == clusterSize - 1 && cx + 1 < clustersX) {
+        markBorder(cluster);
+    }
+    if (y % clusterSize == 0 && cy > 0) {
+        markBorder(horizontal + cluster - clustersX);
+    }
+    if (y % clusterSize == clusterSize - 1 && cy + 1 < clustersY) {
+        markBorder(horizontal + cluster);
+    }
+}
+
+/**
+ * @brief Rebuild the parts of the graph touched by reported cells
+ * @param map Map the graph covers
+ */
+void ClusterGraph::update(const Map& map) {
+    // Borders first: new entrances change the node lists of the clusters
+    // on both sides
+    for (int border : dirtyBorders) {
+        rebuildBorder(map, border);
+        borderDirty[border] = false;
+    }
+    dirtyBorders.clear();
+    
+    for (int cluster : dirtyClusters) {
+        rebuildCluster(map, cluster);
+        clusters[cluster].dirty = false;
+    }
+    dirtyClusters.clear();
+    
+    // Sets can only be merged; a closed cell may split one, so then all
+    // of them are redone
+    bool closed = false;
+    for (int index : changedCells) {
+        closed = closed || (!isOpen(map, index) && setParents[index] != NO_SET);
+    }
+    if (closed) {
+        connectAll(map);
+    } else {
+        for (int index : changedCells) {
+            connectCell(map, index);
+        }
+    }
+    changedCells.clear();
+}
+
+/**
+ * @brief Check whether the graph has been built
+ * @return True after build()
+ */
+bool ClusterGraph::isBuilt() const {
+    return !clusters.empty();
+}
+
+/**
+ * @brief Check whether any path joins two cells
+ * @param from Padded map index
+ * @param to Padded map index
+ * @return True if both cells are walkable and connected
+ */
+bool ClusterGraph::isConnected(int from, int to) const {
+    if (!isBuilt() || setParents[from] == NO_SET || setParents[to] == NO_SET) {
+        return false;
+    }
+    return findSet(from) == findSet(to);
+}
+
+/**
+ * @brief Get the cluster side
+ * @return Cells per cluster side
+ */
+int ClusterGraph::getClusterSize() const {
+    return clusterSize;
+}
+
+/**
+ * @brief Get the cells a cluster covers
+ * @param cluster Cluster number
+ * @param x0 Output, first column
+ * @param y0 Output, first row
+ * @param x1 Output, column past the last one
+ * @param y1 Output, row past the last one
+ */
+void ClusterGraph::getClusterBounds(int cluster, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = (cluster % clustersX) * clusterSize;
+    y0 = (cluster / clustersX) * clusterSize;
+    x1 = std::min(x0 + clusterSize, width);
+    y1 = std::min(y0 + clusterSize, height);
+}
+
+/**
+ * @brief Get the number of node ids in use or free
+ * @return Size a per-node array needs
+ */
+std::size_t ClusterGraph::getNodeCapacity() const {
+    return nodes.size();
+}
+
+/**
+ * @brief Get the number of nodes in the graph
+ * @return Node count
+ */
+std::size_t ClusterGraph::getNodeCount() const {
+    return nodes.size() - freeNodes.size();
+}
+
+/**
+ * @brief Get the number of cluster rebuilds done so far
+ * @return Rebuild count, the initial build included
+ */
+std::uint64_t ClusterGraph::getRebuildCount() const {
+    return rebuildCount;
+}
+
+/**
+ * @brief Check whether a path can go through a cell
+ * @param map Map the graph covers
+ * @param index Padded map index
+ * @return True unless the cell is a wall or a block
+ */
+bool ClusterGraph::isOpen(const Map& map, int index) {
+    CellType cell = map.getCellAt(index);
+    return cell != CellType::WALL && cell != CellType::BLOCK;
+}
+
+/**
+ * @brief Queue a border for rebuilding
+ * @param border Border number
+ */
+void ClusterGraph::markBorder(int border) {
+    if (!borderDirty[border]) {
+        borderDirty[border] = true;
+        dirtyBorders.push_back(border);
+    }
+}
+
+/**
+ * @brief Queue a cluster for rebuilding
+ * @param cluster Cluster number
+ */
+void ClusterGraph::markCluster(int cluster) {
+    if (!clusters[cluster].dirty) {
+        clusters[cluster].dirty = true;
+        dirtyClusters.push_back(cluster);
+    }
+}
+
+/**
+ * @brief Place the entrances of a border between two clusters
+ * @param map Map the graph covers
+ * @param border Border number
+ */
+void ClusterGraph::rebuildBorder(const Map& map, int border) {
+    const int clusterCount = clustersX * clustersY;
+    const bool vertical = border < clusterCount;
+    const int clusterA = vertical ? border : border - clusterCount;
+    const int clusterB = vertical ? clusterA + 1 : clusterA + clustersX;
+    
+    for (int id : borderNodes[border]) {
+        nodes[id].cluster = -1;
+        freeNodes.push_back(id);
+    }
+    borderNodes[border].clear();
+    
+    // Walk along the border: cells of A on its last column (or row), and
+    // the cells of B next to them
+    int x0, y0, x1, y1;
+    getClusterBounds(clusterA, x0, y0, x1, y1);
+    const int length = vertical ? y1 - y0 : x1 - x0;
+    const int first = vertical ? map.getIndex(x1 - 1, y0) : map.getIndex(x0, y1 - 1);
+    const int along = vertical ? stride : 1;
+    const int across = vertical ? 1 : stride;
+    
+    int runStart = -1;
+    for (int i = 0; i <= length; i++) {
+        int cell = first + i * along;
+        bool open = i < length && isOpen(map, cell) && isOpen(map, cell + across);
+        if (open && runStart < 0) {
+            runStart = i;
+        } else if (!open && runStart >= 0) {
+            // One entrance in the middle of a short stretch, one at
+            // each end of a long one
+            int runLength = i - runStart;
+            if (runLength >= SPLIT_ENTRANCE_LENGTH) {
+                int start = first + runStart * along;
+                int end = first + (i - 1) * along;
+                addEntrance(border, start, clusterA, start + across, clusterB);
+                addEntrance(border, end, clusterA, end + across, clusterB);
+            } else {
+                int middle = first + (runStart + runLength / 2) * along;
+                addEntrance(border, middle, clusterA, middle + across, clusterB);
+            }
+            runStart = -1;
+        }
+    }
+    
+    markCluster(clusterA);
+    markCluster(clusterB);
+}
+
+/**
+ * @brief Collect a cluster's nodes and recompute their distances
+ * @param map Map the graph covers
+ * @param cluster Cluster number
+ */
+void ClusterGraph::rebuildCluster(const Map& map, int cluster) {
+    const int clusterCount = clustersX * clustersY;
+    const int cx = cluster % clustersX;
+    const int cy = cluster / clustersX;
+    Cluster& entry = clusters[cluster];
+    
+    // Borders in a fixed order (left, right, top, bottom), so the slots
+    // only depend on the map
+    int borders[4] = {
+        cx > 0 ? cluster - 1 : -1,
+        cx + 1 < clustersX ? cluster : -1,
+        cy > 0 ? clusterCount + cluster - clustersX : -1,
+        cy + 1 < clustersY ? clusterCount + cluster : -1
+    };
+    entry.nodes.clear();
+    for (int border : borders) {
+        if (border < 0) {
+            continue;
+        }
+        for (int id : borderNodes[border]) {
+            if (nodes[id].cluster == cluster) {
+                nodes[id].slot = static_cast<int>(entry.nodes.size());
+                entry.nodes.push_back(id);
+            }
+        }
+    }
+    
+    const std::size_t count = entry.nodes.size();
+    entry.costs.assign(count * count, NO_PATH);
+    rebuildCount++;
+    
+    // One search confined to the cluster from every node
+    int x0, y0, x1, y1;
+    getClusterBounds(cluster, x0, y0, x1, y1);
+    const int offsets[4] = {-stride, stride, -1, 1};
+    const int localOffsets[4] = {-clusterSize, clusterSize, -1, 1};
+    
+    for (std::size_t from = 0; from < count; from++) {
+        std::fill(distances.begin(), distances.end(), NO_PATH);
+        queue.clear();
+        
+        int start = nodes[entry.nodes[from]].cell;
+        int startLocal = (map.getIndexY(start) - y0) * clusterSize + (map.getIndexX(start) - x0);
+        distances[startLocal] = 0;
+        queue.push_back(start);
+        
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            int index = queue[head];
+            int x = map.getIndexX(index);
+            int y = map.getIndexY(index);
+            int local = (y - y0) * clusterSize + (x - x0);
+            std::uint16_t next = static_cast<std::uint16_t>(distances[local] + 1);
+            
+            for (int dir = 0; dir < 4; dir++) {
+                int nx = x + (dir == 2 ? -1 : dir == 3 ? 1 : 0);
+                int ny = y + (dir == 0 ? -1 : dir == 1 ? 1 : 0);
+                if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) {
+                    continue;
+                }
+                int neighbourLocal = local + localOffsets[dir];
+                int neighbour = index + offsets[dir];
+                if (distances[neighbourLocal] == NO_PATH && isOpen(map, neighbour)) {
+                    distances[neighbourLocal] = next;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+        
+        for (std::size_t to = 0; to < count; to++) {
+            int cell = nodes[entry.nodes[to]].cell;
+            int local = (map.getIndexY(cell) - y0) * clusterSize + (map.getIndexX(cell) - x0);
+            entry.costs[from * count + to] = distances[local];
+        }
+    }
+}
+
+/**
+ * @brief Put every walkable cell into its connected set
+ * @param map Map the graph covers
+ */
+void ClusterGraph::connectAll(const Map& map) {
+    setParents.assign(static_cast<std::size_t>(stride) * (height + 2), NO_SET);
+    setRanks.assign(setParents.size(), 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int index = map.getIndex(x, y);
+            if (isOpen(map, index)) {
+                setParents[index] = index;
+            }
+        }
+    }
+    
+    // Joining each cell with the cells above and to the left covers
+    // every pair of neighbours once
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int index = map.getIndex(x, y);
+            if (setParents[index] == NO_SET) {
+                continue;
+            }
+            if (setParents[index - 1] != NO_SET) {
+                joinSets(index, index - 1);
+            }
+            if (setParents[index - stride] != NO_SET) {
+                joinSets(index, index - stride);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Join a newly opened cell with its walkable neighbours
+ * @param map Map the graph covers
+ * @param index Padded map index
+ */
+void ClusterGraph::connectCell(const Map& map, int index) {
+    if (!isOpen(map, index) || setParents[index] != NO_SET) {
+        return;
+    }
+    
+    setParents[index] = index;
+    setRanks[index] = 0;
+    const int offsets[4] = {-stride, stride, -1, 1};
+    for (int offset : offsets) {
+        if (setParents[index + offset] != NO_SET) {
+            joinSets(index, index + offset);
+        }
+    }
+}
+
+/**
+ * @brief Merge the sets of two cells
+ * @param a Padded map index
+ * @param b Padded map index
+ */
+void ClusterGraph::joinSets(int a, int b) {
+    // Union by rank keeps the trees shallow, so lookups stay fast
+    // without having to shorten paths in findSet()
+    int rootA = findSet(a);
+    int rootB = findSet(b);
+    if (rootA == rootB) {
+        return;
+    }
+    if (setRanks[rootA] < setRanks[rootB]) {
+        std::swap(rootA, rootB);
+    }
+    setParents[rootB] = rootA;
+    if (setRanks[rootA] == setRanks[rootB]) {
+        setRanks[rootA]++;
+    }
+}
+
+/**
+ * @brief Get the set of a cell
+ * @param index Padded map index of a walkable cell
+ * @return Padded index of the set's root cell
+ */
+int ClusterGraph::findSet(int index) const {
+    while (setParents[index] != index) {
+        index = setParents[index];
+    }
+    return index;
+}
+
+/**
+ * @brief Add an entrance: a node on each side of a border
+ * @param border Border number
+ * @param cellA Padded index on the first cluster's side
+ * @param clusterA First cluster
+ * @param cellB Padded index on the second cluster's side
+ * @param clusterB Second cluster
+ */
+void ClusterGraph::addEntrance(int border, int cellA, int clusterA, int cellB, int clusterB) {
+    int a = allocateNode();
+    int b = allocateNode();
+    nodes[a] = ClusterNode{cellA, clusterA, -1, b};
+    nodes[b] = ClusterNode{cellB, clusterB, -1, a};
+    borderNodes[border].push_back(a);
+    borderNodes[border].push_back(b);
+}
+
+/**
+ * @brief Get a free node id
+ * @return Node id
+ */
+int ClusterGraph::allocateNode() {
+    if (!freeNodes.empty()) {
+        int id = freeNodes.back();
+        freeNodes.pop_back();
+        return id;
+    }
+    nodes.push_back(ClusterNode{-1, -1, -1, -1});
+    return static_cast<int>(nodes.size()) - 1;
+}
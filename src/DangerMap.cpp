@@ -0,0 +1,200 @@
+#include "../include/DangerMap.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for DangerMap
+ */
+DangerMap::DangerMap() : generation(0), maxRange(0), offsets{0, 0, 0, 0} {
+}
+
+/**
+ * @brief Size the map and clear every cell
+ * @param cellCount Number of cells in the padded map buffer
+ * @param stride Padded row length of the map
+ */
+void DangerMap::reset(std::size_t cellCount, int stride) {
+    ticks.assign(cellCount, NEVER);
+    stamped.clear();
+    stamped.reserve(cellCount);
+    stampedFlags.assign(cellCount, 0);
+    queue.clear();
+    queuedStamps.assign(cellCount, 0);
+    generation = 0;
+    maxRange = 0;
+    offsets[0] = -stride;
+    offsets[1] = stride;
+    offsets[2] = -1;
+    offsets[3] = 1;
+}
+
+/**
+ * @brief Add the footprint of a newly placed bomb
+ * @param map Game map (read only)
+ * @param bombs Active bombs, the new one included
+ * @param bombGrid Bomb handle per padded map index
+ * @param handle The new bomb
+ */
+void DangerMap::addBomb(const Map& map, const BombPool& bombs,
+                        const std::vector<BombPool::Handle>& bombGrid,
+                        BombPool::Handle handle) {
+    const Bomb& bomb = bombs.get(handle);
+    int center = map.getIndex(bomb.getX(), bomb.getY());
+    maxRange = std::max(maxRange, bomb.getExplosionRange());
+    
+    // A bomb placed in another one's footprint goes off with it; either
+    // way its own footprint has to be walked once
+    lower(center, bomb.getDetonationTick());
+    queue.clear();
+    queue.push_back(center);
+    propagate(map, bombs, bombGrid);
+}
+
+/**
+ * @brief Take out the footprints of a chain of bombs that went off
+ * @param map Game map (read only), destroyed blocks already cleared
+ * @param bombs Active bombs, detonated ones already removed
+ * @param bombGrid Bomb handle per padded map index
+ * @param burnedCells Cells the chain set on fire (BlastResult::cells)
+ * @param openedCells Blocks the chain destroyed (BlastResult::destroyedBlocks)
+ */
+void DangerMap::removeChain(const Map& map, const BombPool& bombs,
+                            const std::vector<BombPool::Handle>& bombGrid,
+                            const std::vector<int>& burnedCells,
+                            const std::vector<int>& openedCells) {
+    // Stamps from earlier calls become stale by bumping the generation;
+    // only on wrap-around does the array need clearing
+    if (++generation == 0) {
+        std::fill(queuedStamps.begin(), queuedStamps.end(), 0);
+        generation = 1;
+    }
+    
+    // A remaining bomb inside the chain's footprints would have gone off
+    // with it, so every remaining bomb keeps its tick and only the
+    // burned cells lose theirs
+    for (int index : burnedCells) {
+        ticks[index] = NEVER;
+    }
+    
+    // Bombs still covering a burned cell stamp it again, and bombs whose
+    // rays stopped at a destroyed block now reach past it
+    queue.clear();
+    for (int index : burnedCells) {
+        queueBombsReaching(map, bombs, bombGrid, index);
+    }
+    for (int index : openedCells) {
+        queueBombsReaching(map, bombs, bombGrid, index);
+    }
+    propagate(map, bombs, bombGrid);
+}
+
+/**
+ * @brief Restamp every active bomb from scratch (e.g. after a state restore)
+ * @param map Game map (read only)
+ * @param bombs Active bombs
+ * @param bombGrid Bomb handle per padded map index
+ */
+void DangerMap::rebuild(const Map& map, const BombPool& bombs,
+                        const std::vector<BombPool::Handle>& bombGrid) {
+    for (int index : stamped) {
+        ticks[index] = NEVER;
+        stampedFlags[index] = 0;
+    }
+    stamped.clear();
+    
+    // Seed every bomb with its own fuse; chains then only lower ticks, so
+    // the result does not depend on the order the pool holds the bombs
+    queue.clear();
+    for (const Bomb& bomb : bombs) {
+        int center = map.getIndex(bomb.getX(), bomb.getY());
+        maxRange = std::max(maxRange, bomb.getExplosionRange());
+        lower(center, bomb.getDetonationTick());
+        queue.push_back(center);
+    }
+    propagate(map, bombs, bombGrid);
+}
+
+/**
+ * @brief Lower a cell's tick, remembering newly stamped cells
+ * @param index Padded map index
+ * @param detonationTick Tick fire gets there
+ * @return True if the tick was lowered
+ */
+bool DangerMap::lower(int index, std::uint64_t detonationTick) {
+    if (detonationTick >= ticks[index]) {
+        return false;
+    }
+    if (!stampedFlags[index]) {
+        stampedFlags[index] = 1;
+        stamped.push_back(index);
+    }
+    ticks[index] = detonationTick;
+    return true;
+}
+
+/**
+ * @brief Queue the bombs whose footprint covers a cell
+ * @param map Game map (read only)
+ * @param bombs Active bombs
+ * @param bombGrid Bomb handle per padded map index
+ * @param index Padded map index of a cell that is not a wall
+ */
+void DangerMap::queueBombsReaching(const Map& map, const BombPool& bombs,
+                                   const std::vector<BombPool::Handle>& bombGrid,
+                                   int index) {
+    // Walk outwards as a ray would walk in: a wall or block in between
+    // shields the cell, and no bomb sits on either
+    for (int dir = 0; dir < 4; dir++) {
+        int other = index;
+        for (int r = 1; r <= maxRange; r++) {
+            other += offsets[dir];
+            CellType cell = map.getCellAt(other);
+            if (cell == CellType::WALL || cell == CellType::BLOCK) {
+                break;
+            }
+            
+            BombPool::Handle handle = bombGrid[other];
+            if (handle != BombPool::INVALID_HANDLE && queuedStamps[other] != generation &&
+                bombs.get(handle).getExplosionRange() >= r) {
+                queuedStamps[other] = generation;
+                queue.push_back(other);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Stamp the footprints of the queued bomb cells, following chains
+ * @param map Game map (read only)
+ * @param bombs Active bombs
+ * @param bombGrid Bomb handle per padded map index
+ */
+void DangerMap::propagate(const Map& map, const BombPool& bombs,
+                          const std::vector<BombPool::Handle>& bombGrid) {
+    // A bomb cell is queued again whenever its tick drops, so its
+    // footprint always ends up stamped with its final tick
+    for (std::size_t next = 0; next < queue.size(); next++) {
+        int center = queue[next];
+        std::uint64_t detonationTick = ticks[center];
+        int range = bombs.get(bombGrid[center]).getExplosionRange();
+        
+        // The wall border ends every ray
+        for (int dir = 0; dir < 4; dir++) {
+            int index = center;
+            for (int r = 1; r <= range; r++) {
+                index += offsets[dir];
+                CellType cell = map.getCellAt(index);
+                
+                // Walls stop the fire; blocks burn and stop it, but
+                // nothing can stand on them
+                if (cell == CellType::WALL || cell == CellType::BLOCK) {
+                    break;
+                }
+                
+                if (lower(index, detonationTick) && bombGrid[index] != BombPool::INVALID_HANDLE) {
+                    queue.push_back(index);
+                }
+            }
+        }
+    }
+    queue.clear();
+}
@@ -1,21 +1,17 @@
 #include "../include/Enemy.hpp"
-#include <cstdlib>
-#include <ctime>
+#include "../include/GameState.hpp"
 
 /**
  * @brief Constructor for Enemy
  * @param startX Initial X position on the map
  * @param startY Initial Y position on the map
+ * @param moveDelayTicks Ticks between movements
+ * @param bombDelayTicks Ticks between bomb placements
  */
-Enemy::Enemy(int startX, int startY)
-    : x(startX), y(startY), alive(true), bombCount(1), maxBombs(1),
-      moveTimer(0.0f), bombTimer(0.0f), lastDirection(-1) {
-    // Initialize random seed
-    static bool seeded = false;
-    if (!seeded) {
-        std::srand(static_cast<unsigned int>(std::time(nullptr)));
-        seeded = true;
-    }
+Enemy::Enemy(int startX, int startY, int moveDelayTicks, int bombDelayTicks)
+    : x(startX), y(startY), prevX(startX), prevY(startY), alive(true), bombCount(1), maxBombs(1),
+      moveTimer(0), bombTimer(0), lastDirection(-1),
+      moveDelay(moveDelayTicks), bombDelay(bombDelayTicks) {
 }
 
 /**
@@ -40,6 +36,30 @@ int Enemy::getY() const {
     return y;
 }
 
+/**
+ * @brief Get the X position at the start of the current tick
+ * @return Previous X coordinate
+ */
+int Enemy::getPreviousX() const {
+    return prevX;
+}
+
+/**
+ * @brief Get the Y position at the start of the current tick
+ * @return Previous Y coordinate
+ */
+int Enemy::getPreviousY() const {
+    return prevY;
+}
+
+/**
+ * @brief Remember the current position as the previous one (start of a tick)
+ */
+void Enemy::storePreviousPosition() {
+    prevX = x;
+    prevY = y;
+}
+
 /**
  * @brief Move the enemy up
  */
@@ -102,6 +122,22 @@ void Enemy::setBombCount(int count) {
     }
 }
 
+/**
+ * @brief Get maximum bomb capacity
+ * @return Maximum number of bombs
+ */
+int Enemy::getMaxBombs() const {
+    return maxBombs;
+}
+
+/**
+ * @brief Get the ticks left before the bomb timer allows another bomb
+ * @return Ticks, 0 if a bomb may be placed now
+ */
+int Enemy::getTicksUntilBombReady() const {
+    return bombTimer >= bombDelay ? 0 : bombDelay - bombTimer;
+}
+
 /**
  * @brief Check if enemy can place a bomb
  * @return True if enemy can place a bomb
@@ -116,36 +152,67 @@ bool Enemy::canPlaceBomb() const {
 void Enemy::placeBomb() {
     if (bombCount > 0) {
         bombCount--;
-        bombTimer = 0.0f; // Reset bomb timer
+        bombTimer = 0; // Reset bomb timer
     }
 }
 
 /**
- * @brief Update enemy AI behavior
- * @param deltaTime Time elapsed since last update
+ * @brief Advance enemy AI behavior by one tick
+ * @param random Enemy AI random stream of the match
  * @return True if enemy wants to place a bomb, false otherwise
  */
-bool Enemy::update(float deltaTime) {
-    moveTimer += deltaTime;
-    bombTimer += deltaTime;
+bool Enemy::update(Random& random) {
+    moveTimer++;
+    bombTimer++;
     
     // Randomly decide to place a bomb (30% chance when timer is ready)
     bool wantsToPlaceBomb = false;
     if (bombTimer >= bombDelay && canPlaceBomb()) {
-        int random = std::rand() % 100;
-        if (random < 30) { // 30% chance to place bomb
+        if (random.chance(30)) { // 30% chance to place bomb
             wantsToPlaceBomb = true;
         }
     }
     
     // Update last direction for movement (will be used by Game class)
     if (moveTimer >= moveDelay) {
-        moveTimer = 0.0f;
+        moveTimer = 0;
         // Direction will be chosen randomly by Game class based on walkability
-        lastDirection = std::rand() % 4; // 0=up, 1=down, 2=left, 3=right
+        lastDirection = static_cast<int>(random.nextBelow(4)); // 0=up, 1=down, 2=left, 3=right
     }
     
     return wantsToPlaceBomb;
 }
 
+/**
+ * @brief Copy the enemy into a packed state
+ * @param state Output state
+ */
+void Enemy::saveState(EnemyState& state) const {
+    state.x = static_cast<std::int16_t>(x);
+    state.y = static_cast<std::int16_t>(y);
+    state.prevX = static_cast<std::int16_t>(prevX);
+    state.prevY = static_cast<std::int16_t>(prevY);
+    state.moveTimer = moveTimer;
+    state.bombTimer = bombTimer;
+    state.bombCount = static_cast<std::int8_t>(bombCount);
+    state.maxBombs = static_cast<std::int8_t>(maxBombs);
+    state.lastDirection = static_cast<std::int8_t>(lastDirection);
+    state.alive = alive;
+}
 
+/**
+ * @brief Overwrite the enemy with a packed state
+ * @param state Saved state
+ */
+void Enemy::restoreState(const EnemyState& state) {
+    x = state.x;
+    y = state.y;
+    prevX = state.prevX;
+    prevY = state.prevY;
+    moveTimer = state.moveTimer;
+    bombTimer = state.bombTimer;
+    bombCount = state.bombCount;
+    maxBombs = state.maxBombs;
+    lastDirection = state.lastDirection;
+    alive = state.alive;
+}
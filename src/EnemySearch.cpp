@@ -0,0 +1,357 @@
+#include "../include/EnemySearch.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const int CATCH_SCORE = 1000000;       ///< Reaching the player, minus the ticks it takes
+const int DISTANCE_WEIGHT = 100;        ///< Per step of flow field distance to the player
+const int MAX_DISTANCE = 400;           ///< Distance charged for cells with no path
+const int HIT_PLAYER_SCORE = 2000;      ///< Planned bomb reaching the player's cell
+const int CORNER_PLAYER_SCORE = 300;    ///< Per player neighbour a planned bomb reaches
+const int UNSAFE_SCORE = 20000;         ///< Plan ending on a cell fire will still reach
+const int BOMB_COST = 50;               ///< Per planned bomb, so bombs are not dropped for nothing
+
+}
+
+/**
+ * @brief Constructor for EnemySearch
+ * @param beamWidth Plans kept per level (clamped to MAX_BEAM)
+ * @param depth Moves per plan (clamped to MAX_DEPTH)
+ */
+EnemySearch::EnemySearch(int beamWidth, int depth)
+    : beamWidth(std::max(1, std::min(beamWidth, MAX_BEAM))),
+      depth(std::max(1, std::min(depth, MAX_DEPTH))),
+      problem(nullptr), maxNodes(0), nodeCount(0), completedDepth(0),
+      offsets{0, 0, 0, 0} {
+    // Nine children per plan at most, so searching never allocates
+    beam.reserve(MAX_BEAM * 9);
+    children.reserve(MAX_BEAM * 9);
+}
+
+/**
+ * @brief Choose the next action of an enemy
+ * @param problem What the enemy knows
+ * @param deadline Time by which the search has to stop
+ * @param maxNodes Node evaluations allowed
+ * @param action Output, set only on success
+ * @return True if at least one search level finished
+ */
+bool EnemySearch::decide(const SearchProblem& problem,
+                         std::chrono::steady_clock::time_point deadline,
+                         int maxNodes,
+                         EnemyAction& action) {
+    this->problem = &problem;
+    this->deadline = deadline;
+    this->maxNodes = maxNodes;
+    nodeCount = 0;
+    completedDepth = 0;
+    
+    const int stride = problem.map->getStride();
+    offsets[0] = -stride;
+    offsets[1] = stride;
+    offsets[2] = -1;
+    offsets[3] = 1;
+    
+    Node root;
+    root.cell = problem.enemyCell;
+    root.firstDirection = -1;
+    root.firstBomb = false;
+    root.caught = false;
+    root.bombsLeft = problem.bombsLeft;
+    root.bombReadyTick = problem.tick + static_cast<std::uint64_t>(std::max(0, problem.ticksUntilBombReady));
+    root.ownCount = 0;
+    root.score = 0;
+    
+    beam.clear();
+    beam.push_back(root);
+    
+    // The beam is sorted after every level, so its front is the answer
+    // of the deepest level finished so far
+    for (int level = 0; level < depth; level++) {
+        if (!expand(level)) {
+            break;
+        }
+        completedDepth = level + 1;
+        action.direction = beam[0].firstDirection;
+        action.placeBomb = beam[0].firstBomb;
+    }
+    
+    this->problem = nullptr;
+    return completedDepth > 0;
+}
+
+/**
+ * @brief Get the node evaluations of the last decide() call
+ * @return Node count
+ */
+int EnemySearch::getNodeCount() const {
+    return nodeCount;
+}
+
+/**
+ * @brief Get the deepest level the last decide() call finished
+ * @return Plan length in moves
+ */
+int EnemySearch::getCompletedDepth() const {
+    return completedDepth;
+}
+
+/**
+ * @brief Expand every plan of the beam by one move
+ * @param depth Moves already in the plans
+ * @return False if the budget ran out or no plan survived
+ */
+bool EnemySearch::expand(int depth) {
+    const std::uint64_t arrival = problem->tick + static_cast<std::uint64_t>(depth) * problem->moveDelay;
+    const std::uint64_t leave = arrival + problem->moveDelay - 1;
+    const std::vector<BombPool::Handle>& bombGrid = *problem->bombGrid;
+    
+    children.clear();
+    for (const Node& parent : beam) {
+        if (outOfBudget()) {
+            return false;
+        }
+        
+        // A plan that reached the player is finished
+        if (parent.caught) {
+            children.push_back(parent);
+            continue;
+        }
+        
+        bool canBomb = parent.bombsLeft > 0 && arrival >= parent.bombReadyTick &&
+                       parent.ownCount < MAX_OWN_BOMBS &&
+                       !(bombGrid[parent.cell] != BombPool::INVALID_HANDLE &&
+                         problem->danger->getDetonationTick(parent.cell) >= arrival);
+        
+        // Four directions, then staying; bombs only drop when moving away
+        for (int dir = 0; dir < 5; dir++) {
+            int direction = dir < 4 ? dir : -1;
+            int target = direction < 0 ? parent.cell : parent.cell + offsets[direction];
+            if (direction >= 0 && !isOpen(parent, target, arrival)) {
+                continue;
+            }
+            
+            for (int bomb = 0; bomb < 2; bomb++) {
+                if (bomb && (direction < 0 || !canBomb)) {
+                    continue;
+                }
+                
+                Node child = parent;
+                if (depth == 0) {
+                    child.firstDirection = direction;
+                    child.firstBomb = bomb != 0;
+                }
+                
+                if (bomb) {
+                    // Set off early if the cell is already in another footprint
+                    std::uint64_t detonation = arrival + problem->bombFuse;
+                    std::uint64_t chained = problem->danger->getDetonationTick(parent.cell);
+                    if (chained >= arrival && chained < detonation) {
+                        detonation = chained;
+                    }
+                    child.ownCells[child.ownCount] = parent.cell;
+                    child.ownTicks[child.ownCount] = detonation;
+                    child.ownCount++;
+                    child.bombsLeft--;
+                    child.bombReadyTick = arrival + problem->bombDelay;
+                }
+                
+                nodeCount++;
+                if (burns(child, target, arrival, leave)) {
+                    continue;
+                }
+                
+                child.cell = target;
+                child.caught = target == problem->playerCell;
+                child.score = child.caught ? CATCH_SCORE - static_cast<int>(arrival - problem->tick)
+                                           : evaluate(child, leave + 1);
+                children.push_back(child);
+            }
+        }
+    }
+    
+    if (children.empty()) {
+        return false;
+    }
+    
+    // Best first; equal scores keep generation order, so the result is
+    // the same on every run
+    std::stable_sort(children.begin(), children.end(),
+                     [](const Node& a, const Node& b) { return a.score > b.score; });
+    
+    // Keep the best plan of each distinct outcome
+    beam.clear();
+    for (const Node& child : children) {
+        if (static_cast<int>(beam.size()) == beamWidth) {
+            break;
+        }
+        
+        bool duplicate = false;
+        for (const Node& kept : beam) {
+            if (kept.cell == child.cell && kept.ownCount == child.ownCount &&
+                kept.bombsLeft == child.bombsLeft && kept.caught == child.caught &&
+                std::equal(kept.ownCells, kept.ownCells + kept.ownCount, child.ownCells)) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            beam.push_back(child);
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Check if a plan's enemy can step onto a cell
+ * @param node Plan
+ * @param cell Padded index
+ * @param arrival Tick of the step
+ * @return True if nothing blocks the cell
+ */
+bool EnemySearch::isOpen(const Node& node, int cell, std::uint64_t arrival) const {
+    const Map& map = *problem->map;
+    CellType type = map.getCellAt(cell);
+    if (type == CellType::WALL || type == CellType::BLOCK) {
+        return false;
+    }
+    
+    // Enemies never step into fire
+    if (type == CellType::EXPLOSION && map.getExplosionExpiry(cell) >= arrival) {
+        return false;
+    }
+    
+    // Bombs block their cell until they go off
+    if ((*problem->bombGrid)[cell] != BombPool::INVALID_HANDLE &&
+        problem->danger->getDetonationTick(cell) >= arrival) {
+        return false;
+    }
+    for (int i = 0; i < node.ownCount; i++) {
+        if (node.ownCells[i] == cell && node.ownTicks[i] >= arrival) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Check if fire reaches a cell while the enemy stands there
+ * @param node Plan
+ * @param cell Padded index
+ * @param from First tick on the cell
+ * @param to Last tick on the cell
+ * @return True if the enemy would burn
+ */
+bool EnemySearch::burns(const Node& node, int cell, std::uint64_t from, std::uint64_t to) const {
+    const Map& map = *problem->map;
+    const std::uint64_t duration = static_cast<std::uint64_t>(problem->explosionDuration);
+    
+    // Fire lit at tick d burns through tick d + duration
+    if (map.getCellAt(cell) == CellType::EXPLOSION && map.getExplosionExpiry(cell) >= from) {
+        return true;
+    }
+    
+    std::uint64_t detonation = problem->danger->getDetonationTick(cell);
+    if (detonation != DangerMap::NEVER && detonation <= to && detonation + duration >= from) {
+        return true;
+    }
+    
+    for (int i = 0; i < node.ownCount; i++) {
+        if (node.ownTicks[i] <= to && node.ownTicks[i] + duration >= from &&
+            covers(node.ownCells[i], cell)) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Check if a bomb's rays reach a cell
+ * @param bombCell Padded index of the bomb
+ * @param cell Padded index
+ * @return True if the cell is in the footprint
+ */
+bool EnemySearch::covers(int bombCell, int cell) const {
+    if (bombCell == cell) {
+        return true;
+    }
+    
+    const Map& map = *problem->map;
+    int bombX = map.getIndexX(bombCell);
+    int bombY = map.getIndexY(bombCell);
+    int cellX = map.getIndexX(cell);
+    int cellY = map.getIndexY(cell);
+    
+    int distance;
+    int step;
+    if (bombY == cellY) {
+        distance = std::abs(cellX - bombX);
+        step = cellX > bombX ? 1 : -1;
+    } else if (bombX == cellX) {
+        distance = std::abs(cellY - bombY);
+        step = cellY > bombY ? map.getStride() : -map.getStride();
+    } else {
+        return false;
+    }
+    if (distance > problem->bombRange) {
+        return false;
+    }
+    
+    // Walls and blocks in between stop the ray
+    for (int index = bombCell + step; index != cell; index += step) {
+        CellType type = map.getCellAt(index);
+        if (type == CellType::WALL || type == CellType::BLOCK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Score a plan
+ * @param node Plan
+ * @param arrival Tick the plan ends
+ * @return Evaluation, higher is better
+ */
+int EnemySearch::evaluate(const Node& node, std::uint64_t arrival) const {
+    const Map& map = *problem->map;
+    
+    // Close in on the player
+    std::uint32_t distance = problem->flow->getDistance(node.cell);
+    int score = -DISTANCE_WEIGHT * static_cast<int>(std::min<std::uint32_t>(distance, MAX_DISTANCE));
+    
+    // Planned bombs are worth what they threaten: the player's cell, or
+    // the cells the player would flee to
+    for (int i = 0; i < node.ownCount; i++) {
+        if (covers(node.ownCells[i], problem->playerCell)) {
+            score += HIT_PLAYER_SCORE;
+            continue;
+        }
+        for (int offset : offsets) {
+            int neighbour = problem->playerCell + offset;
+            if (map.getCellAt(neighbour) != CellType::WALL && covers(node.ownCells[i], neighbour)) {
+                score += CORNER_PLAYER_SCORE;
+            }
+        }
+    }
+    score -= BOMB_COST * node.ownCount;
+    
+    // A plan that ends where fire is still coming has not escaped yet
+    if (burns(node, node.cell, arrival, DangerMap::NEVER - 1)) {
+        score -= UNSAFE_SCORE;
+    }
+    
+    return score;
+}
+
+/**
+ * @brief Check whether the budget is spent
+ * @return True if the search has to stop
+ */
+bool EnemySearch::outOfBudget() const {
+    return nodeCount >= maxNodes || std::chrono::steady_clock::now() >= deadline;
+}
@@ -0,0 +1,196 @@
+#include "../include/FlowField.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for FlowField
+ */
+FlowField::FlowField()
+    : offsets{0, 0, 0, 0}, target(-1), sweptTarget(-1), maxDistance(UNREACHABLE - 1),
+      needsSweep(true), sweepCount(0) {
+}
+
+/**
+ * @brief Size the field for a map and mark it for a full sweep
+ * @param cellCount Number of cells in the padded map buffer
+ * @param stride Padded row length of the map
+ */
+void FlowField::reset(std::size_t cellCount, int stride) {
+    distances.assign(cellCount, UNREACHABLE);
+    queue.clear();
+    queue.reserve(cellCount);
+    reachedCells.clear();
+    openedCells.clear();
+    offsets[0] = -stride;
+    offsets[1] = stride;
+    offsets[2] = -1;
+    offsets[3] = 1;
+    target = -1;
+    sweptTarget = -1;
+    needsSweep = true;
+}
+
+/**
+ * @brief Stop the field at a walking distance from the target
+ * @param distance Furthest distance kept (UNREACHABLE - 1: no limit)
+ */
+void FlowField::setMaxDistance(std::uint32_t distance) {
+    maxDistance = distance < UNREACHABLE ? distance : UNREACHABLE - 1;
+    invalidate();
+}
+
+/**
+ * @brief Set the target cell (a full sweep follows if it moved)
+ * @param index Padded buffer index of the target
+ */
+void FlowField::setTarget(int index) {
+    target = index;
+}
+
+/**
+ * @brief Report a cell that became passable
+ * @param index Padded buffer index
+ */
+void FlowField::openCell(int index) {
+    if (!needsSweep) {
+        openedCells.push_back(index);
+    }
+}
+
+/**
+ * @brief Report a cell that became impassable
+ * @param index Padded buffer index
+ */
+void FlowField::closeCell(int index) {
+    // Only paths through the cell get longer; unreachable cells stay so
+    if (distances[index] != UNREACHABLE) {
+        needsSweep = true;
+        openedCells.clear();
+    }
+}
+
+/**
+ * @brief Force a full sweep on the next update
+ */
+void FlowField::invalidate() {
+    needsSweep = true;
+    openedCells.clear();
+}
+
+/**
+ * @brief Bring the distances up to date with the reported changes
+ * @param map Map the field covers
+ * @param bombGrid Bomb handle per padded index (INVALID_HANDLE if none)
+ */
+void FlowField::update(const Map& map, const std::vector<BombPool::Handle>& bombGrid) {
+    if (target < 0) {
+        return;
+    }
+    
+    if (needsSweep || target != sweptTarget) {
+        sweep(map, bombGrid);
+        return;
+    }
+    
+    if (openedCells.empty()) {
+        return;
+    }
+    
+    // An opened cell is one step further than its best neighbour
+    queue.clear();
+    for (int index : openedCells) {
+        if (!isPassable(map, bombGrid, index)) {
+            continue;
+        }
+        
+        std::uint32_t best = distances[index];
+        for (int offset : offsets) {
+            std::uint32_t neighbour = distances[index + offset];
+            if (neighbour != UNREACHABLE && neighbour + 1 < best) {
+                best = neighbour + 1;
+            }
+        }
+        
+        if (best < distances[index] && best <= maxDistance) {
+            distances[index] = best;
+            queue.push_back(index);
+            reachedCells.push_back(index);
+        }
+    }
+    openedCells.clear();
+    
+    relax(map, bombGrid);
+}
+
+/**
+ * @brief Get the number of full sweeps done so far
+ * @return Full sweep count
+ */
+std::uint64_t FlowField::getSweepCount() const {
+    return sweepCount;
+}
+
+/**
+ * @brief Check if a path can go through a cell
+ * @param map Map the field covers
+ * @param bombGrid Bomb handle per padded index
+ * @param index Padded buffer index
+ * @return True for walkable cells without a bomb
+ */
+bool FlowField::isPassable(const Map& map, const std::vector<BombPool::Handle>& bombGrid, int index) {
+    // Explosions only last a moment, so paths may run through them
+    CellType cell = map.getCellAt(index);
+    return (cell == CellType::EMPTY || cell == CellType::EXPLOSION) &&
+           bombGrid[index] == BombPool::INVALID_HANDLE;
+}
+
+/**
+ * @brief Recompute every distance from the target
+ * @param map Map the field covers
+ * @param bombGrid Bomb handle per padded index
+ */
+void FlowField::sweep(const Map& map, const std::vector<BombPool::Handle>& bombGrid) {
+    // Only cells the last sweep reached have a distance to forget, which
+    // on a large map with a limited reach is a small part of it
+    for (int index : reachedCells) {
+        distances[index] = UNREACHABLE;
+    }
+    reachedCells.clear();
+    
+    // The target counts as passable even when the player stands on a bomb
+    distances[target] = 0;
+    queue.clear();
+    queue.push_back(target);
+    reachedCells.push_back(target);
+    relax(map, bombGrid);
+    
+    sweptTarget = target;
+    needsSweep = false;
+    openedCells.clear();
+    sweepCount++;
+}
+
+/**
+ * @brief Lower distances outwards from the cells already queued
+ * @param map Map the field covers
+ * @param bombGrid Bomb handle per padded index
+ */
+void FlowField::relax(const Map& map, const std::vector<BombPool::Handle>& bombGrid) {
+    // The border is all walls, so neighbours of queued cells are always
+    // inside the buffer
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        int index = queue[head];
+        std::uint32_t next = distances[index] + 1;
+        if (next > maxDistance) {
+            continue;
+        }
+        
+        for (int offset : offsets) {
+            int neighbour = index + offset;
+            if (next < distances[neighbour] && isPassable(map, bombGrid, neighbour)) {
+                distances[neighbour] = next;
+                queue.push_back(neighbour);
+                reachedCells.push_back(neighbour);
+            }
+        }
+    }
+}
@@ -1,29 +1,32 @@
 #include "../include/Game.hpp"
-#include "../include/Enemy.hpp"
-#include <iostream>
 #include <algorithm>
-#include <optional>
-#include <cstdlib>
 #include <ctime>
+#include <iostream>
+#include <optional>
 
 /**
  * @brief Constructor for Game
  * @param windowWidth Width of the game window
  * @param windowHeight Height of the game window
+ * @param tickRate Simulation ticks per second
  */
-Game::Game(int windowWidth, int windowHeight)
-    : window(nullptr), player(nullptr), map(nullptr),
+Game::Game(int windowWidth, int windowHeight, int tickRate)
+    : window(nullptr), simulation(nullptr), scheduler(tickRate),
       windowWidth(windowWidth), windowHeight(windowHeight),
-      cellSize(30), mapWidth(21), mapHeight(15),
-      isRunning(false), gameOver(false), youWin(false),
-      moveUpPressed(false), moveDownPressed(false),
-      moveLeftPressed(false), moveRightPressed(false),
-      moveTimer(0.0f), playerStartX(1), playerStartY(1),
+      cellSize(30), mapWidth(21), mapHeight(15), enemyCount(3),
+      seed(static_cast<std::uint32_t>(std::time(nullptr))), enemyAi(EnemyAi::STANDARD),
+      workerThreads(1), isRunning(false), interpolationAlpha(1.0f),
+#ifdef BOMBERMAN_PROFILING
+      profilerOverlayVisible(false),
+#endif
       bombPlaceSound(nullptr), bombExplodeSound(nullptr),
       gameOverSound(nullptr), youWinSound(nullptr),
-      powerUpSound(nullptr), audioEnabled(false) {
-    // Initialize random seed for enemy AI
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+      powerUpSound(nullptr), audioEnabled(false),
+      simulationRunning(false),
+      moveUpPressed(false), moveDownPressed(false),
+      moveLeftPressed(false), moveRightPressed(false),
+      bombPresses(0), bombPressesHandled(0), replaying(false), hudLives(-1) {
+    playedEvents.fill(0);
 }
 
 /**
@@ -33,6 +36,65 @@ Game::~Game() {
     cleanup();
 }
 
+/**
+ * @brief Set the seed of the match (call before initialize)
+ * @param seed Simulation seed
+ */
+void Game::setSeed(std::uint32_t seed) {
+    this->seed = seed;
+}
+
+/**
+ * @brief Choose how enemies decide (call before initialize)
+ * @param ai Enemy AI
+ * @param budget Limits of the search enemy AI
+ */
+void Game::setEnemyAi(EnemyAi ai, const SearchBudget& budget) {
+    enemyAi = ai;
+    searchBudget = budget;
+}
+
+/**
+ * @brief Set the threads deciding for the enemies (call before initialize)
+ * @param count Threads including the simulation thread
+ */
+void Game::setWorkerThreads(int count) {
+    workerThreads = count;
+}
+
+/**
+ * @brief Record the input of the match (call before initialize)
+ * @param path Replay file written when the game ends
+ */
+void Game::recordTo(const std::string& path) {
+    recordPath = path;
+}
+
+/**
+ * @brief Play a recorded match instead of reading the keyboard (call before initialize)
+ * @param path Replay file
+ * @return True if the replay was loaded
+ */
+bool Game::loadReplay(const std::string& path) {
+    if (!replay.load(path)) {
+        return false;
+    }
+    
+    // Recreate the recorded match
+    const ReplayHeader& header = replay.getHeader();
+    seed = header.seed;
+    mapWidth = header.mapWidth;
+    mapHeight = header.mapHeight;
+    enemyCount = header.enemyCount;
+    enemyAi = header.enemyAi;
+    searchBudget = header.searchBudget;
+    // Only the node limit is reproducible; files may still carry a time limit
+    searchBudget.microseconds = 0;
+    scheduler = TickScheduler(header.tickRate);
+    replaying = true;
+    return true;
+}
+
 /**
  * @brief Initialize the game
  * @return True if initialization was successful
@@ -50,28 +112,60 @@ bool Game::initialize() {
         return false;
     }
     
-    window->setFramerateLimit(60);
+    // Render at the display rate; interpolation keeps motion smooth at any
+    // simulation tick rate
+    window->setVerticalSyncEnabled(true);
     
-    // Create map
-    map = new Map(mapWidth, mapHeight);
-    if (!map) {
-        std::cerr << "Error: Could not create map" << std::endl;
+    // Create the match (map, player and enemies)
+    simulation = new Simulation(mapWidth, mapHeight, scheduler.getTickRate(), enemyCount, seed);
+    if (!simulation) {
+        std::cerr << "Error: Could not create simulation" << std::endl;
         return false;
     }
-    
-    // Create player at starting position
-    playerStartX = 1;
-    playerStartY = 1;
-    player = new Player(playerStartX, playerStartY);
-    if (!player) {
-        std::cerr << "Error: Could not create player" << std::endl;
+    if (!recordPath.empty() && !replaying && enemyAi == EnemyAi::SEARCH && searchBudget.microseconds != 0) {
+        // A search stopped by the clock depends on the speed of the machine,
+        // so a recorded match only limits the nodes of each search
+        std::cerr << "Warning: --record ignores the search time limit; enemies search up to "
+                  << searchBudget.nodesPerEnemy << " nodes each" << std::endl;
+        searchBudget.microseconds = 0;
+    }
+    simulation->setEnemyAi(enemyAi, searchBudget);
+    simulation->setWorkerThreads(workerThreads);
+    
+    if (!recordPath.empty() && !replaying) {
+        ReplayHeader header;
+        header.seed = seed;
+        header.tickRate = scheduler.getTickRate();
+        header.mapWidth = mapWidth;
+        header.mapHeight = mapHeight;
+        header.enemyCount = enemyCount;
+        header.enemyAi = enemyAi;
+        header.searchBudget = searchBudget;
+        replay.startRecording(header);
+    }
+    
+    // Publish the initial state so there is always a snapshot to draw
+    gameClock.restart();
+    snapshots.writeBuffer().capture(*simulation, cellChanges);
+    snapshots.writeBuffer().tickTime = 0;
+    snapshots.publish();
+    snapshots.update();
+    
+    // Build the map geometry once; new snapshots only update changed cells
+    tileMap.build(snapshots.read(), cellSize,
+                  sf::Vector2f((windowWidth - mapWidth * cellSize) / 2,
+                               (windowHeight - mapHeight * cellSize) / 2));
+    
+    // Generate the texture atlas shared by every entity sprite
+    if (!sprites.initialize()) {
+        std::cerr << "Error: Could not create sprite atlas" << std::endl;
         return false;
     }
     
-    // Create enemies at different starting positions
-    enemies.push_back(new Enemy(mapWidth - 2, mapHeight - 2));
-    enemies.push_back(new Enemy(mapWidth - 2, 1));
-    enemies.push_back(new Enemy(1, mapHeight - 2));
+    // Overlays never change, so they are built once
+    buildGameOverScreen();
+    buildYouWinScreen();
+    buildHUD(snapshots.read().lives);
     
     // Initialize audio system (optional - game works without audio files)
     initializeAudio();
@@ -80,454 +174,238 @@ bool Game::initialize() {
     // For now, we'll use SFML's default rendering
     
     isRunning = true;
-    gameOver = false;
-    clock.restart();
     
     return true;
 }
 
 /**
  * @brief Run the main game loop
+ * 
+ * The simulation runs on its own thread; this thread handles window
+ * events and draws the latest published snapshot, so a slow frame does
+ * not hold back the simulation and vice versa.
  */
 void Game::run() {
+    startSimulation();
+    
     while (isRunning && window->isOpen()) {
-        // SFML 3.0 uses std::optional for events
-        while (const std::optional<sf::Event> event = window->pollEvent()) {
-            if (event->is<sf::Event::Closed>()) {
-                window->close();
-                isRunning = false;
-            }
-            
-            // Handle key press events
-            if (event->is<sf::Event::KeyPressed>()) {
-                const auto* keyEvent = event->getIf<sf::Event::KeyPressed>();
-                if (keyEvent) {
-                    if (keyEvent->code == sf::Keyboard::Key::Up) {
-                        moveUpPressed = true;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Down) {
-                        moveDownPressed = true;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Left) {
-                        moveLeftPressed = true;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Right) {
-                        moveRightPressed = true;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Space) {
-                        // Place bomb
-                        if (player->canPlaceBomb()) {
-                            // Check if there's already a bomb at this position
-                            bool bombExists = false;
-                            for (Bomb* bomb : bombs) {
-                                if (bomb->getX() == player->getX() && 
-                                    bomb->getY() == player->getY()) {
-                                    bombExists = true;
-                                    break;
-                                }
-                            }
-                            
-                            if (!bombExists) {
-                                // Use player's bomb range
-                                Bomb* newBomb = new Bomb(player->getX(), player->getY(), 
-                                                         Bomb::OwnerType::PLAYER, 
-                                                         3.0f, 
-                                                         player->getBombRange());
-                                bombs.push_back(newBomb);
-                                player->placeBomb();
-                                
-                                // Play bomb placement sound
-                                playSound("bomb_place");
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // Handle key release events
-            if (event->is<sf::Event::KeyReleased>()) {
-                const auto* keyEvent = event->getIf<sf::Event::KeyReleased>();
-                if (keyEvent) {
-                    if (keyEvent->code == sf::Keyboard::Key::Up) {
-                        moveUpPressed = false;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Down) {
-                        moveDownPressed = false;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Left) {
-                        moveLeftPressed = false;
-                    } else if (keyEvent->code == sf::Keyboard::Key::Right) {
-                        moveRightPressed = false;
-                    }
-                }
-            }
-        }
-        
-        // Process continuous movement
-        processInput();
+        PROFILE_FRAME();
         
-        // Calculate delta time
-        float deltaTime = clock.restart().asSeconds();
+        handleEvents();
         
-        // Update game state
-        update(deltaTime);
+        // Pick up the latest simulation tick, if a new one was published
+        if (snapshots.update()) {
+            PROFILE_ZONE(SNAPSHOT);
+            tileMap.update(snapshots.read());
+            playEventSounds();
+        }
         
         // Render game
         render();
     }
-}
-
-/**
- * @brief Process user input
- */
-void Game::processInput() {
-    if (!player || !player->isAlive()) {
-        return;
-    }
     
-    float moveDeltaTime = moveClock.restart().asSeconds();
-    moveTimer += moveDeltaTime;
+    stopSimulation();
     
-    if (moveTimer >= moveDelay) {
-        int newX = player->getX();
-        int newY = player->getY();
-        bool moved = false;
-        
-        if (moveUpPressed) {
-            newY = player->getY() - 1;
-            moved = true;
-        } else if (moveDownPressed) {
-            newY = player->getY() + 1;
-            moved = true;
-        } else if (moveLeftPressed) {
-            newX = player->getX() - 1;
-            moved = true;
-        } else if (moveRightPressed) {
-            newX = player->getX() + 1;
-            moved = true;
-        }
-        
-        if (moved && map->isWalkable(newX, newY)) {
-            // Check if there's a bomb at the new position
-            bool bombAtPosition = false;
-            for (Bomb* bomb : bombs) {
-                if (bomb->getX() == newX && bomb->getY() == newY) {
-                    bombAtPosition = true;
-                    break;
-                }
-            }
-            
-            if (!bombAtPosition) {
-                if (moveUpPressed) {
-                    player->moveUp();
-                } else if (moveDownPressed) {
-                    player->moveDown();
-                } else if (moveLeftPressed) {
-                    player->moveLeft();
-                } else if (moveRightPressed) {
-                    player->moveRight();
-                }
-                moveTimer = 0.0f;
-            }
+    if (!recordPath.empty() && !replaying) {
+        if (replay.save(recordPath)) {
+            std::cout << "Recorded " << replay.getTickCount() << " ticks (seed " << seed
+                      << ") to " << recordPath << std::endl;
+        } else {
+            std::cerr << "Error: Could not write replay " << recordPath << std::endl;
         }
     }
 }
 
 /**
- * @brief Update game state
- * @param deltaTime Time elapsed since last update
+ * @brief Poll window events and forward input to the simulation thread
  */
-void Game::update(float deltaTime) {
-    if (gameOver || youWin) {
-        return;
-    }
-    
-    // Handle player death and respawn
-    if (player && !player->isAlive()) {
-        handlePlayerDeath();
-    }
-    
-    if (!player || !player->isAlive()) {
-        return;
-    }
-    
-    // Update enemies AI
-    static float enemyMoveTimer = 0.0f;
-    enemyMoveTimer += deltaTime;
-    
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            // Update enemy AI
-            bool wantsToPlaceBomb = enemy->update(deltaTime);
-            
-            // Move enemy first, then place bomb in previous position
-            bool enemyMoved = false;
-            int previousX = enemy->getX();
-            int previousY = enemy->getY();
-            
-            // Move enemy randomly
-            if (enemyMoveTimer >= 0.3f) {
-                enemyMoveTimer = 0.0f;
-                
-                // Try random directions until finding a walkable one
-                int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
-                int dirOrder[4] = {std::rand() % 4, std::rand() % 4, std::rand() % 4, std::rand() % 4};
-                
-                for (int i = 0; i < 4; i++) {
-                    int dir = dirOrder[i];
-                    int newX = enemy->getX() + directions[dir][0];
-                    int newY = enemy->getY() + directions[dir][1];
-                    
-                    if (map->isWalkable(newX, newY)) {
-                        // Check if there's a bomb at the new position
-                        bool bombAtPosition = false;
-                        for (Bomb* bomb : bombs) {
-                            if (bomb->getX() == newX && bomb->getY() == newY) {
-                                bombAtPosition = true;
-                                break;
-                            }
-                        }
-                        
-                        // Also check for explosions
-                        bool explosionAtPosition = (map->getCell(newX, newY) == CellType::EXPLOSION);
-                        
-                        if (!bombAtPosition && !explosionAtPosition) {
-                            // Save previous position before moving
-                            previousX = enemy->getX();
-                            previousY = enemy->getY();
-                            
-                            // Move enemy
-                            if (dir == 0) enemy->moveUp();
-                            else if (dir == 1) enemy->moveDown();
-                            else if (dir == 2) enemy->moveLeft();
-                            else if (dir == 3) enemy->moveRight();
-                            
-                            enemyMoved = true;
-                            break;
-                        }
-                    }
+void Game::handleEvents() {
+    PROFILE_ZONE(EVENTS);
+    
+    // SFML 3.0 uses std::optional for events
+    while (const std::optional<sf::Event> event = window->pollEvent()) {
+        if (event->is<sf::Event::Closed>()) {
+            window->close();
+            isRunning = false;
+        }
+        
+        // Handle key press events
+        if (event->is<sf::Event::KeyPressed>()) {
+            const auto* keyEvent = event->getIf<sf::Event::KeyPressed>();
+            if (keyEvent) {
+                if (keyEvent->code == sf::Keyboard::Key::Up) {
+                    moveUpPressed.store(true, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Down) {
+                    moveDownPressed.store(true, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Left) {
+                    moveLeftPressed.store(true, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Right) {
+                    moveRightPressed.store(true, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Space) {
+                    // Place bomb on the next simulation step
+                    bombPresses.fetch_add(1, std::memory_order_relaxed);
                 }
-            }
-            
-            // Place bomb in previous position if enemy wants to and has moved
-            // This ensures enemy is not trapped by its own bomb
-            if (wantsToPlaceBomb && enemy->canPlaceBomb() && enemyMoved) {
-                // Check if there's already a bomb at the previous position
-                bool bombExists = false;
-                for (Bomb* bomb : bombs) {
-                    if (bomb->getX() == previousX && bomb->getY() == previousY) {
-                        bombExists = true;
-                        break;
+#ifdef BOMBERMAN_PROFILING
+                else if (keyEvent->code == sf::Keyboard::Key::F3) {
+                    profilerOverlayVisible = !profilerOverlayVisible;
+                } else if (keyEvent->code == sf::Keyboard::Key::F4) {
+                    if (Profiler::instance().exportChromeTrace("bomberman_trace.json")) {
+                        std::cout << "Profiler trace written to bomberman_trace.json" << std::endl;
+                    } else {
+                        std::cerr << "Error: Could not write profiler trace" << std::endl;
                     }
                 }
-                
-                if (!bombExists) {
-                    // Place bomb at previous position (where enemy was before moving)
-                    Bomb* newBomb = new Bomb(previousX, previousY, Bomb::OwnerType::ENEMY);
-                    bombs.push_back(newBomb);
-                    enemy->placeBomb();
-                }
+#endif
             }
         }
-    }
-    
-    if (enemyMoveTimer >= 0.3f) {
-        enemyMoveTimer = 0.0f;
-    }
-    
-    // Update bombs
-    bombsToRemove.clear();
-    for (Bomb* bomb : bombs) {
-        if (bomb->update(deltaTime)) {
-            // Bomb exploded
-            handleBombExplosion(*bomb);
-            bombsToRemove.push_back(bomb);
-        }
-    }
-    
-    // Remove exploded bombs
-    for (Bomb* bomb : bombsToRemove) {
-        auto it = std::find(bombs.begin(), bombs.end(), bomb);
-        if (it != bombs.end()) {
-            // Get bomb owner from bomb itself
-            Bomb::OwnerType owner = bomb->getOwner();
-            
-            delete *it;
-            bombs.erase(it);
-            
-            // Return bomb to the owner
-            if (owner == Bomb::OwnerType::PLAYER && player) {
-                player->setBombCount(player->getBombCount() + 1);
-            } else if (owner == Bomb::OwnerType::ENEMY) {
-                // Return to a random alive enemy
-                for (Enemy* enemy : enemies) {
-                    if (enemy && enemy->isAlive()) {
-                        enemy->setBombCount(enemy->getBombCount() + 1);
-                        break;
-                    }
+        
+        // Handle key release events
+        if (event->is<sf::Event::KeyReleased>()) {
+            const auto* keyEvent = event->getIf<sf::Event::KeyReleased>();
+            if (keyEvent) {
+                if (keyEvent->code == sf::Keyboard::Key::Up) {
+                    moveUpPressed.store(false, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Down) {
+                    moveDownPressed.store(false, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Left) {
+                    moveLeftPressed.store(false, std::memory_order_relaxed);
+                } else if (keyEvent->code == sf::Keyboard::Key::Right) {
+                    moveRightPressed.store(false, std::memory_order_relaxed);
                 }
             }
         }
     }
-    
-    // Check collisions with explosions
-    checkPlayerCollisions();
-    checkEnemyCollisions();
-    
-    // Check power-up collisions
-    checkPowerUpCollisions();
-    
-    // Check victory condition
-    checkVictory();
-    
-    // Clear explosions after a short delay (handled in next frame)
-    static float explosionTimer = 0.0f;
-    explosionTimer += deltaTime;
-    if (explosionTimer >= 0.5f) {
-        map->clearExplosions();
-        explosionTimer = 0.0f;
-    }
 }
 
 /**
- * @brief Handle bomb explosions
- * @param bomb The bomb that exploded
+ * @brief Start the simulation thread
  */
-void Game::handleBombExplosion(const Bomb& bomb) {
-    // Play explosion sound
-    playSound("bomb_explode");
-    
-    // Store positions where blocks were destroyed (for power-up spawning)
-    std::vector<std::pair<int, int>> destroyedBlocks;
-    
-    int range = bomb.getExplosionRange();
-    int x = bomb.getX();
-    int y = bomb.getY();
-    
-    // Check center explosion
-    if (map->isValidPosition(x, y)) {
-        CellType cell = map->getCell(x, y);
-        if (cell == CellType::BLOCK) {
-            destroyedBlocks.push_back({x, y});
-        }
-    }
-    
-    // Check explosions in four directions
-    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
-    
-    for (int dir = 0; dir < 4; dir++) {
-        for (int r = 1; r <= range; r++) {
-            int newX = x + directions[dir][0] * r;
-            int newY = y + directions[dir][1] * r;
-            
-            if (!map->isValidPosition(newX, newY)) {
-                break;
-            }
-            
-            CellType cell = map->getCell(newX, newY);
-            
-            // Stop explosion at walls
-            if (cell == CellType::WALL) {
-                break;
-            }
-            
-            // Track destroyed blocks
-            if (cell == CellType::BLOCK) {
-                destroyedBlocks.push_back({newX, newY});
-                break; // Stop explosion after destroying block
-            }
-        }
+void Game::startSimulation() {
+    if (simulationThread.joinable()) {
+        return;
     }
     
-    // Create explosion
-    map->createExplosion(x, y, range);
-    
-    // Spawn power-ups at destroyed block positions (30% chance each)
-    for (const auto& pos : destroyedBlocks) {
-        if (std::rand() % 100 < 30) {
-            spawnPowerUp(pos.first, pos.second);
-        }
-    }
+    simulationRunning.store(true, std::memory_order_release);
+    simulationThread = std::thread(&Game::simulationLoop, this);
 }
 
 /**
- * @brief Check collisions between player and explosions
+ * @brief Stop the simulation thread and wait for it to finish
  */
-void Game::checkPlayerCollisions() {
-    if (!player || !player->isAlive()) {
-        return;
-    }
-    
-    // Check collision with explosions
-    CellType cell = map->getCell(player->getX(), player->getY());
-    if (cell == CellType::EXPLOSION) {
-        player->kill();
-        return;
-    }
-    
-    // Check collision with enemies
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            if (enemy->getX() == player->getX() && enemy->getY() == player->getY()) {
-                // Enemy touched player - kill player
-                player->kill();
-                return;
-            }
-        }
+void Game::stopSimulation() {
+    simulationRunning.store(false, std::memory_order_release);
+    if (simulationThread.joinable()) {
+        simulationThread.join();
     }
 }
 
 /**
- * @brief Check collisions between enemies and explosions
+ * @brief Body of the simulation thread
+ * 
+ * Runs the ticks that became due, publishes a snapshot after each batch
+ * and sleeps until the next tick.
  */
-void Game::checkEnemyCollisions() {
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            CellType cell = map->getCell(enemy->getX(), enemy->getY());
-            if (cell == CellType::EXPLOSION) {
-                enemy->kill();
-            }
+void Game::simulationLoop() {
+    scheduler.reset();
+    std::int64_t lastTime = gameClock.getElapsedTime().asMicroseconds();
+    
+    while (simulationRunning.load(std::memory_order_acquire)) {
+        std::int64_t now = gameClock.getElapsedTime().asMicroseconds();
+        int ticks = scheduler.advance(now - lastTime);
+        lastTime = now;
+        
+        for (int i = 0; i < ticks; i++) {
+            update();
+        }
+        
+        if (ticks > 0) {
+            PROFILE_ZONE(SNAPSHOT);
+            
+            // Stamp the snapshot with the time its tick became due, not the
+            // time this thread happened to wake up
+            GameSnapshot& snapshot = snapshots.writeBuffer();
+            snapshot.capture(*simulation, cellChanges);
+            snapshot.tickTime = now - (scheduler.getTickMicroseconds() -
+                                       scheduler.getMicrosecondsUntilNextTick());
+            snapshots.publish();
         }
+        
+        sf::sleep(sf::microseconds(scheduler.getMicrosecondsUntilNextTick()));
     }
 }
 
 /**
- * @brief Check if all enemies are dead (victory condition)
+ * @brief Translate held keys into simulation input
+ */
+void Game::processInput() {
+    input.moveUp = moveUpPressed.load(std::memory_order_relaxed);
+    input.moveDown = moveDownPressed.load(std::memory_order_relaxed);
+    input.moveLeft = moveLeftPressed.load(std::memory_order_relaxed);
+    input.moveRight = moveRightPressed.load(std::memory_order_relaxed);
+    
+    // Space presses since the last step place a single bomb, not one per tick
+    std::uint32_t presses = bombPresses.load(std::memory_order_relaxed);
+    input.placeBomb = presses != bombPressesHandled;
+    bombPressesHandled = presses;
+}
+
+/**
+ * @brief Advance the game state by one simulation tick
  */
-void Game::checkVictory() {
-    if (youWin || gameOver) {
+void Game::update() {
+    if (!simulation) {
         return;
     }
     
-    bool allEnemiesDead = true;
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            allEnemiesDead = false;
-            break;
+    {
+        PROFILE_ZONE(INPUT);
+        if (replaying) {
+            // Once the recording ends the match continues without input
+            if (!replay.next(input)) {
+                input = SimulationInput();
+            }
+        } else {
+            processInput();
+            if (!recordPath.empty()) {
+                replay.record(input);
+            }
         }
     }
     
-    if (allEnemiesDead && enemies.size() > 0) {
-        youWin = true;
-        // Play victory sound
-        playSound("you_win");
-    }
+    PROFILE_ZONE(UPDATE);
+    simulation->step(input);
+    cellChanges.record(simulation->getMap());
 }
 
 /**
- * @brief Handle player death and respawn
+ * @brief Play sounds for the events since the previous snapshot
  */
-void Game::handlePlayerDeath() {
-    if (!player) {
-        return;
-    }
+void Game::playEventSounds() {
+    const GameSnapshot& view = snapshots.read();
     
-    // Check lives BEFORE respawn (kill() already reduced lives)
-    // We need to check if there are lives remaining AFTER the death
-    int currentLives = player->getLives();
-    
-    if (currentLives > 0) {
-        // Respawn player at starting position
-        player->respawn(playerStartX, playerStartY);
-    } else {
-        // Game over - no lives left
-        gameOver = true;
-        // Play game over sound
-        playSound("game_over");
+    for (int i = 0; i < SIMULATION_EVENT_TYPES; i++) {
+        if (view.eventCounts[i] == playedEvents[i]) {
+            continue;
+        }
+        playedEvents[i] = view.eventCounts[i];
+        
+        switch (static_cast<SimulationEvent>(i)) {
+            case SimulationEvent::BOMB_PLACED:
+                playSound("bomb_place");
+                break;
+            case SimulationEvent::BOMB_EXPLODED:
+                playSound("bomb_explode");
+                break;
+            case SimulationEvent::POWERUP_COLLECTED:
+                playSound("powerup");
+                break;
+            case SimulationEvent::GAME_OVER:
+                playSound("game_over");
+                break;
+            case SimulationEvent::YOU_WIN:
+                playSound("you_win");
+                break;
+        }
     }
 }
 
@@ -539,119 +417,120 @@ void Game::render() {
         return;
     }
     
+    renderFrame();
+    
+#ifdef BOMBERMAN_PROFILING
+    if (profilerOverlayVisible) {
+        drawProfilerOverlay();
+    }
+#endif
+    
+    PROFILE_ZONE(DISPLAY);
+    window->display();
+}
+
+/**
+ * @brief Draw the latest snapshot into the window
+ */
+void Game::renderFrame() {
+    PROFILE_ZONE(RENDER);
+    
     window->clear(sf::Color::Black);
     
+    const GameSnapshot& view = snapshots.read();
+    
+    // Entities are drawn between the previous and the latest tick: alpha
+    // goes from 0 when the tick became due to 1 one tick later
+    std::int64_t sinceTick = gameClock.getElapsedTime().asMicroseconds() - view.tickTime;
+    interpolationAlpha = static_cast<float>(sinceTick) / scheduler.getTickMicroseconds();
+    interpolationAlpha = std::clamp(interpolationAlpha, 0.0f, 1.0f);
+    
     // Draw map
     drawMap();
     
-    // Draw bombs
-    drawBombs();
-    
     // Draw explosions
     drawExplosions();
     
-    // Draw enemies
+    // Batch every entity sprite and draw them in one call
+    sprites.clear();
+    drawBombs();
     drawEnemies();
-    
-    // Draw power-ups
     drawPowerUps();
-    
-    // Draw player
-    if (player && player->isAlive()) {
+    if (view.playerAlive) {
         drawPlayer();
     }
+    window->draw(sprites);
     
     // Draw HUD
     drawHUD();
     
     // Draw game over or victory screen
-    if (gameOver) {
+    if (view.gameOver) {
         drawGameOver();
-    } else if (youWin) {
+    } else if (view.victory) {
         drawYouWin();
     }
-    
-    window->display();
 }
 
 /**
- * @brief Draw the map using ASCII symbols
+ * @brief Draw the map from the cached tile vertex array
  */
 void Game::drawMap() {
-    if (!map || !window) {
+    if (!simulation || !window) {
         return;
     }
     
-    int offsetX = (windowWidth - mapWidth * cellSize) / 2;
-    int offsetY = (windowHeight - mapHeight * cellSize) / 2;
-    
-    for (int y = 0; y < mapHeight; y++) {
-        for (int x = 0; x < mapWidth; x++) {
-            CellType cell = map->getCell(x, y);
-            sf::RectangleShape rect(sf::Vector2f(cellSize - 1, cellSize - 1));
-            rect.setPosition(sf::Vector2f(offsetX + x * cellSize, offsetY + y * cellSize));
-            
-            switch (cell) {
-                case CellType::EMPTY:
-                    rect.setFillColor(sf::Color(50, 50, 50));
-                    break;
-                case CellType::WALL:
-                    rect.setFillColor(sf::Color(100, 50, 0));
-                    break;
-                case CellType::BLOCK:
-                    rect.setFillColor(sf::Color(150, 75, 0));
-                    break;
-                case CellType::EXPLOSION:
-                    rect.setFillColor(sf::Color::Red);
-                    break;
-            }
-            
-            window->draw(rect);
-        }
-    }
+    window->draw(tileMap);
 }
 
 /**
- * @brief Draw the player
+ * @brief Add the player to the sprite batch
  */
 void Game::drawPlayer() {
-    if (!player || !window) {
+    if (!simulation || !window) {
         return;
     }
     
+    float diameter = 2 * (cellSize / 2 - 2);
+    
+    sprites.add(SpriteShape::CIRCLE,
+                getInterpolatedPosition(snapshots.read().player) + sf::Vector2f(1, 1),
+                sf::Vector2f(diameter, diameter), sf::Color::Blue);
+}
+
+/**
+ * @brief Get the screen position of an entity between the last two ticks
+ * @param entity Entity with its previous and current cell
+ * @return Top-left pixel of the entity's cell at interpolationAlpha
+ */
+sf::Vector2f Game::getInterpolatedPosition(const SnapshotEntity& entity) const {
     int offsetX = (windowWidth - mapWidth * cellSize) / 2;
     int offsetY = (windowHeight - mapHeight * cellSize) / 2;
     
-    sf::CircleShape playerShape(cellSize / 2 - 2);
-    playerShape.setPosition(sf::Vector2f(
-        offsetX + player->getX() * cellSize + 1,
-        offsetY + player->getY() * cellSize + 1
-    ));
-    playerShape.setFillColor(sf::Color::Blue);
+    float x = entity.prevX + (entity.x - entity.prevX) * interpolationAlpha;
+    float y = entity.prevY + (entity.y - entity.prevY) * interpolationAlpha;
     
-    window->draw(playerShape);
+    return sf::Vector2f(offsetX + x * cellSize, offsetY + y * cellSize);
 }
 
 /**
- * @brief Draw the bombs
+ * @brief Add the bombs to the sprite batch
  */
 void Game::drawBombs() {
-    if (!window) {
+    if (!simulation || !window) {
         return;
     }
     
     int offsetX = (windowWidth - mapWidth * cellSize) / 2;
     int offsetY = (windowHeight - mapHeight * cellSize) / 2;
     
-    for (Bomb* bomb : bombs) {
-        sf::CircleShape bombShape(cellSize / 3);
-        bombShape.setPosition(sf::Vector2f(
-            offsetX + bomb->getX() * cellSize + cellSize / 3,
-            offsetY + bomb->getY() * cellSize + cellSize / 3
-        ));
-        bombShape.setFillColor(sf::Color::Black);
-        
-        window->draw(bombShape);
+    float diameter = 2 * (cellSize / 3);
+    
+    for (const SnapshotEntity& bomb : snapshots.read().bombs) {
+        sprites.add(SpriteShape::CIRCLE,
+                    sf::Vector2f(offsetX + bomb.x * cellSize + cellSize / 3,
+                                 offsetY + bomb.y * cellSize + cellSize / 3),
+                    sf::Vector2f(diameter, diameter), sf::Color::Black);
     }
 }
 
@@ -664,27 +543,19 @@ void Game::drawExplosions() {
 }
 
 /**
- * @brief Draw the enemies
+ * @brief Add the enemies to the sprite batch
  */
 void Game::drawEnemies() {
-    if (!window) {
+    if (!simulation || !window) {
         return;
     }
     
-    int offsetX = (windowWidth - mapWidth * cellSize) / 2;
-    int offsetY = (windowHeight - mapHeight * cellSize) / 2;
+    float diameter = 2 * (cellSize / 2 - 2);
     
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            sf::CircleShape enemyShape(cellSize / 2 - 2);
-            enemyShape.setPosition(sf::Vector2f(
-                offsetX + enemy->getX() * cellSize + 1,
-                offsetY + enemy->getY() * cellSize + 1
-            ));
-            enemyShape.setFillColor(sf::Color::Red);
-            
-            window->draw(enemyShape);
-        }
+    for (const SnapshotEntity& enemy : snapshots.read().enemies) {
+        sprites.add(SpriteShape::CIRCLE,
+                    getInterpolatedPosition(enemy) + sf::Vector2f(1, 1),
+                    sf::Vector2f(diameter, diameter), sf::Color::Red);
     }
 }
 
@@ -692,339 +563,176 @@ void Game::drawEnemies() {
  * @brief Draw HUD (lives, etc.)
  */
 void Game::drawHUD() {
-    if (!window || !player) {
+    if (!window || !simulation) {
         return;
     }
     
-    // Draw lives indicator using simple shapes
-    int offsetX = 10;
-    int offsetY = 10;
-    
-    // Draw "Lives: " text representation using rectangles
-    for (int i = 0; i < player->getLives(); i++) {
-        sf::RectangleShape lifeRect(sf::Vector2f(20, 20));
-        lifeRect.setPosition(sf::Vector2f(offsetX + i * 25, offsetY));
-        lifeRect.setFillColor(sf::Color::Green);
-        lifeRect.setOutlineColor(sf::Color::White);
-        lifeRect.setOutlineThickness(1);
-        window->draw(lifeRect);
+    // The geometry only changes when the lives count does
+    int lives = snapshots.read().lives;
+    if (lives != hudLives) {
+        buildHUD(lives);
     }
+    
+    window->draw(hud);
 }
 
 /**
- * @brief Draw power-ups
+ * @brief Add the power-ups to the sprite batch
  */
 void Game::drawPowerUps() {
-    if (!window) {
+    if (!simulation || !window) {
         return;
     }
     
     int offsetX = (windowWidth - mapWidth * cellSize) / 2;
     int offsetY = (windowHeight - mapHeight * cellSize) / 2;
     
-    for (PowerUp* powerUp : powerUps) {
-        if (powerUp && !powerUp->isCollected()) {
-            sf::RectangleShape powerUpShape(sf::Vector2f(cellSize / 2, cellSize / 2));
-            powerUpShape.setPosition(sf::Vector2f(
-                offsetX + powerUp->getX() * cellSize + cellSize / 4,
-                offsetY + powerUp->getY() * cellSize + cellSize / 4
-            ));
-            
-            // Different colors for different power-up types
-            switch (powerUp->getType()) {
-                case PowerUpType::EXTRA_BOMB:
-                    powerUpShape.setFillColor(sf::Color::Yellow);
-                    break;
-                case PowerUpType::EXTRA_LIFE:
-                    powerUpShape.setFillColor(sf::Color::Magenta);
-                    break;
-                case PowerUpType::INCREASE_RANGE:
-                    powerUpShape.setFillColor(sf::Color::Cyan);
-                    break;
-            }
-            
-            window->draw(powerUpShape);
+    for (const SnapshotPowerUp& powerUp : snapshots.read().powerUps) {
+        // Different colors for different power-up types
+        sf::Color color = sf::Color::Yellow;
+        switch (powerUp.type) {
+            case PowerUpType::EXTRA_BOMB:
+                color = sf::Color::Yellow;
+                break;
+            case PowerUpType::EXTRA_LIFE:
+                color = sf::Color::Magenta;
+                break;
+            case PowerUpType::INCREASE_RANGE:
+                color = sf::Color::Cyan;
+                break;
         }
+        
+        sprites.add(SpriteShape::SQUARE,
+                    sf::Vector2f(offsetX + powerUp.x * cellSize + cellSize / 4,
+                                 offsetY + powerUp.y * cellSize + cellSize / 4),
+                    sf::Vector2f(cellSize / 2, cellSize / 2), color);
     }
 }
 
 /**
- * @brief Check collisions between player and power-ups
+ * @brief Draw game over screen
  */
-void Game::checkPowerUpCollisions() {
-    if (!player || !player->isAlive()) {
+void Game::drawGameOver() {
+    if (!window) {
         return;
     }
     
-    for (PowerUp* powerUp : powerUps) {
-        if (powerUp && !powerUp->isCollected()) {
-            if (powerUp->getX() == player->getX() && powerUp->getY() == player->getY()) {
-                // Play power-up collection sound
-                playSound("powerup");
-                
-                // Apply power-up effect
-                switch (powerUp->getType()) {
-                    case PowerUpType::EXTRA_BOMB:
-                        player->increaseMaxBombs();
-                        break;
-                    case PowerUpType::EXTRA_LIFE:
-                        player->addLife();
-                        break;
-                    case PowerUpType::INCREASE_RANGE:
-                        player->increaseBombRange();
-                        break;
-                }
-                
-                powerUp->collect();
-            }
-        }
-    }
-    
-    // Remove collected power-ups
-    powerUps.erase(
-        std::remove_if(powerUps.begin(), powerUps.end(),
-            [](PowerUp* pu) {
-                if (pu && pu->isCollected()) {
-                    delete pu;
-                    return true;
-                }
-                return false;
-            }),
-        powerUps.end()
-    );
+    window->draw(gameOverScreen);
 }
 
 /**
- * @brief Spawn a power-up at a position (random chance)
- * @param x X coordinate
- * @param y Y coordinate
+ * @brief Draw you win screen
  */
-void Game::spawnPowerUp(int x, int y) {
-    // Check if there's already a power-up at this position
-    for (PowerUp* powerUp : powerUps) {
-        if (powerUp && powerUp->getX() == x && powerUp->getY() == y) {
-            return; // Don't spawn if already exists
-        }
-    }
-    
-    // Randomly choose power-up type
-    int random = std::rand() % 3;
-    PowerUpType type;
-    switch (random) {
-        case 0:
-            type = PowerUpType::EXTRA_BOMB;
-            break;
-        case 1:
-            type = PowerUpType::EXTRA_LIFE;
-            break;
-        case 2:
-            type = PowerUpType::INCREASE_RANGE;
-            break;
-        default:
-            type = PowerUpType::EXTRA_BOMB;
+void Game::drawYouWin() {
+    if (!window) {
+        return;
     }
     
-    PowerUp* newPowerUp = new PowerUp(x, y, type);
-    powerUps.push_back(newPowerUp);
+    window->draw(youWinScreen);
 }
 
 /**
- * @brief Draw game over screen
+ * @brief Append an axis-aligned rectangle to a triangle vertex array
+ * @param vertices Vertex array using PrimitiveType::Triangles
+ * @param x Left edge
+ * @param y Top edge
+ * @param width Rectangle width
+ * @param height Rectangle height
+ * @param color Fill color
  */
-void Game::drawGameOver() {
-    if (!window) {
-        return;
-    }
+void Game::appendRect(sf::VertexArray& vertices, float x, float y,
+                      float width, float height, sf::Color color) {
+    sf::Vertex topLeft{sf::Vector2f(x, y), color, sf::Vector2f()};
+    sf::Vertex topRight{sf::Vector2f(x + width, y), color, sf::Vector2f()};
+    sf::Vertex bottomLeft{sf::Vector2f(x, y + height), color, sf::Vector2f()};
+    sf::Vertex bottomRight{sf::Vector2f(x + width, y + height), color, sf::Vector2f()};
+    
+    vertices.append(topLeft);
+    vertices.append(topRight);
+    vertices.append(bottomLeft);
+    vertices.append(bottomLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+}
+
+/**
+ * @brief Build the game over screen geometry
+ */
+void Game::buildGameOverScreen() {
+    gameOverScreen.clear();
+    gameOverScreen.setPrimitiveType(sf::PrimitiveType::Triangles);
     
-    // Draw semi-transparent overlay
-    sf::RectangleShape overlay(sf::Vector2f(windowWidth, windowHeight));
-    overlay.setFillColor(sf::Color(0, 0, 0, 200));
-    window->draw(overlay);
+    // Semi-transparent overlay
+    appendRect(gameOverScreen, 0, 0, windowWidth, windowHeight, sf::Color(0, 0, 0, 200));
     
-    // Draw "GAME OVER" text using rectangles (since we don't have font loaded)
+    // "GAME OVER" text using rectangles (since we don't have font loaded)
     int centerX = windowWidth / 2;
     int centerY = windowHeight / 2;
     int textSize = 60;
     
-    // Draw large rectangles to represent "GAME OVER"
+    auto addRect = [&](float x, float y, float w, float h) {
+        appendRect(gameOverScreen, x, y, w, h, sf::Color::Red);
+    };
+    
     // G
-    sf::RectangleShape g1(sf::Vector2f(textSize, 10));
-    g1.setPosition(sf::Vector2f(centerX - 150, centerY - 30));
-    g1.setFillColor(sf::Color::Red);
-    window->draw(g1);
-    
-    sf::RectangleShape g2(sf::Vector2f(10, textSize));
-    g2.setPosition(sf::Vector2f(centerX - 150, centerY - 30));
-    g2.setFillColor(sf::Color::Red);
-    window->draw(g2);
-    
-    sf::RectangleShape g3(sf::Vector2f(textSize, 10));
-    g3.setPosition(sf::Vector2f(centerX - 150, centerY + 20));
-    g3.setFillColor(sf::Color::Red);
-    window->draw(g3);
-    
-    sf::RectangleShape g4(sf::Vector2f(10, textSize / 2));
-    g4.setPosition(sf::Vector2f(centerX - 90, centerY));
-    g4.setFillColor(sf::Color::Red);
-    window->draw(g4);
+    addRect(centerX - 150, centerY - 30, textSize, 10);
+    addRect(centerX - 150, centerY - 30, 10, textSize);
+    addRect(centerX - 150, centerY + 20, textSize, 10);
+    addRect(centerX - 90, centerY, 10, textSize / 2);
     
     // A
-    sf::RectangleShape a1(sf::Vector2f(10, textSize));
-    a1.setPosition(sf::Vector2f(centerX - 50, centerY - 30));
-    a1.setFillColor(sf::Color::Red);
-    window->draw(a1);
-    
-    sf::RectangleShape a2(sf::Vector2f(textSize, 10));
-    a2.setPosition(sf::Vector2f(centerX - 50, centerY - 30));
-    a2.setFillColor(sf::Color::Red);
-    window->draw(a2);
-    
-    sf::RectangleShape a3(sf::Vector2f(10, textSize));
-    a3.setPosition(sf::Vector2f(centerX + 10, centerY - 30));
-    a3.setFillColor(sf::Color::Red);
-    window->draw(a3);
-    
-    sf::RectangleShape a4(sf::Vector2f(textSize, 10));
-    a4.setPosition(sf::Vector2f(centerX - 50, centerY + 5));
-    a4.setFillColor(sf::Color::Red);
-    window->draw(a4);
+    addRect(centerX - 50, centerY - 30, 10, textSize);
+    addRect(centerX - 50, centerY - 30, textSize, 10);
+    addRect(centerX + 10, centerY - 30, 10, textSize);
+    addRect(centerX - 50, centerY + 5, textSize, 10);
     
     // M
-    sf::RectangleShape m1(sf::Vector2f(10, textSize));
-    m1.setPosition(sf::Vector2f(centerX + 50, centerY - 30));
-    m1.setFillColor(sf::Color::Red);
-    window->draw(m1);
-    
-    sf::RectangleShape m2(sf::Vector2f(10, textSize));
-    m2.setPosition(sf::Vector2f(centerX + 110, centerY - 30));
-    m2.setFillColor(sf::Color::Red);
-    window->draw(m2);
-    
-    sf::RectangleShape m3(sf::Vector2f(10, textSize / 2));
-    m3.setPosition(sf::Vector2f(centerX + 70, centerY - 10));
-    m3.setFillColor(sf::Color::Red);
-    window->draw(m3);
+    addRect(centerX + 50, centerY - 30, 10, textSize);
+    addRect(centerX + 110, centerY - 30, 10, textSize);
+    addRect(centerX + 70, centerY - 10, 10, textSize / 2);
     
     // E
-    sf::RectangleShape e1(sf::Vector2f(10, textSize));
-    e1.setPosition(sf::Vector2f(centerX + 130, centerY - 30));
-    e1.setFillColor(sf::Color::Red);
-    window->draw(e1);
-    
-    sf::RectangleShape e2(sf::Vector2f(textSize / 2, 10));
-    e2.setPosition(sf::Vector2f(centerX + 130, centerY - 30));
-    e2.setFillColor(sf::Color::Red);
-    window->draw(e2);
-    
-    sf::RectangleShape e3(sf::Vector2f(textSize / 2, 10));
-    e3.setPosition(sf::Vector2f(centerX + 130, centerY + 5));
-    e3.setFillColor(sf::Color::Red);
-    window->draw(e3);
-    
-    sf::RectangleShape e4(sf::Vector2f(textSize / 2, 10));
-    e4.setPosition(sf::Vector2f(centerX + 130, centerY + 20));
-    e4.setFillColor(sf::Color::Red);
-    window->draw(e4);
+    addRect(centerX + 130, centerY - 30, 10, textSize);
+    addRect(centerX + 130, centerY - 30, textSize / 2, 10);
+    addRect(centerX + 130, centerY + 5, textSize / 2, 10);
+    addRect(centerX + 130, centerY + 20, textSize / 2, 10);
     
     // O (for OVER)
-    sf::RectangleShape o1(sf::Vector2f(10, textSize));
-    o1.setPosition(sf::Vector2f(centerX - 150, centerY + 50));
-    o1.setFillColor(sf::Color::Red);
-    window->draw(o1);
-    
-    sf::RectangleShape o2(sf::Vector2f(textSize, 10));
-    o2.setPosition(sf::Vector2f(centerX - 150, centerY + 50));
-    o2.setFillColor(sf::Color::Red);
-    window->draw(o2);
-    
-    sf::RectangleShape o3(sf::Vector2f(10, textSize));
-    o3.setPosition(sf::Vector2f(centerX - 90, centerY + 50));
-    o3.setFillColor(sf::Color::Red);
-    window->draw(o3);
-    
-    sf::RectangleShape o4(sf::Vector2f(textSize, 10));
-    o4.setPosition(sf::Vector2f(centerX - 150, centerY + 100));
-    o4.setFillColor(sf::Color::Red);
-    window->draw(o4);
+    addRect(centerX - 150, centerY + 50, 10, textSize);
+    addRect(centerX - 150, centerY + 50, textSize, 10);
+    addRect(centerX - 90, centerY + 50, 10, textSize);
+    addRect(centerX - 150, centerY + 100, textSize, 10);
     
     // V (for OVER)
-    sf::RectangleShape v1(sf::Vector2f(10, textSize - 20));
-    v1.setPosition(sf::Vector2f(centerX - 50, centerY + 50));
-    v1.setFillColor(sf::Color::Red);
-    window->draw(v1);
-    
-    sf::RectangleShape v2(sf::Vector2f(10, textSize - 20));
-    v2.setPosition(sf::Vector2f(centerX - 10, centerY + 50));
-    v2.setFillColor(sf::Color::Red);
-    window->draw(v2);
-    
-    sf::RectangleShape v3(sf::Vector2f(10, 20));
-    v3.setPosition(sf::Vector2f(centerX - 30, centerY + 100));
-    v3.setFillColor(sf::Color::Red);
-    window->draw(v3);
+    addRect(centerX - 50, centerY + 50, 10, textSize - 20);
+    addRect(centerX - 10, centerY + 50, 10, textSize - 20);
+    addRect(centerX - 30, centerY + 100, 10, 20);
     
     // E (for OVER)
-    sf::RectangleShape e5(sf::Vector2f(10, textSize));
-    e5.setPosition(sf::Vector2f(centerX + 10, centerY + 50));
-    e5.setFillColor(sf::Color::Red);
-    window->draw(e5);
-    
-    sf::RectangleShape e6(sf::Vector2f(textSize / 2, 10));
-    e6.setPosition(sf::Vector2f(centerX + 10, centerY + 50));
-    e6.setFillColor(sf::Color::Red);
-    window->draw(e6);
-    
-    sf::RectangleShape e7(sf::Vector2f(textSize / 2, 10));
-    e7.setPosition(sf::Vector2f(centerX + 10, centerY + 75));
-    e7.setFillColor(sf::Color::Red);
-    window->draw(e7);
-    
-    sf::RectangleShape e8(sf::Vector2f(textSize / 2, 10));
-    e8.setPosition(sf::Vector2f(centerX + 10, centerY + 100));
-    e8.setFillColor(sf::Color::Red);
-    window->draw(e8);
+    addRect(centerX + 10, centerY + 50, 10, textSize);
+    addRect(centerX + 10, centerY + 50, textSize / 2, 10);
+    addRect(centerX + 10, centerY + 75, textSize / 2, 10);
+    addRect(centerX + 10, centerY + 100, textSize / 2, 10);
     
     // R (for OVER)
-    sf::RectangleShape r1(sf::Vector2f(10, textSize));
-    r1.setPosition(sf::Vector2f(centerX + 50, centerY + 50));
-    r1.setFillColor(sf::Color::Red);
-    window->draw(r1);
-    
-    sf::RectangleShape r2(sf::Vector2f(textSize / 2, 10));
-    r2.setPosition(sf::Vector2f(centerX + 50, centerY + 50));
-    r2.setFillColor(sf::Color::Red);
-    window->draw(r2);
-    
-    sf::RectangleShape r3(sf::Vector2f(10, textSize / 2));
-    r3.setPosition(sf::Vector2f(centerX + 80, centerY + 50));
-    r3.setFillColor(sf::Color::Red);
-    window->draw(r3);
-    
-    sf::RectangleShape r4(sf::Vector2f(textSize / 2, 10));
-    r4.setPosition(sf::Vector2f(centerX + 50, centerY + 75));
-    r4.setFillColor(sf::Color::Red);
-    window->draw(r4);
-    
-    sf::RectangleShape r5(sf::Vector2f(10, textSize / 2));
-    r5.setPosition(sf::Vector2f(centerX + 80, centerY + 85));
-    r5.setFillColor(sf::Color::Red);
-    window->draw(r5);
+    addRect(centerX + 50, centerY + 50, 10, textSize);
+    addRect(centerX + 50, centerY + 50, textSize / 2, 10);
+    addRect(centerX + 80, centerY + 50, 10, textSize / 2);
+    addRect(centerX + 50, centerY + 75, textSize / 2, 10);
+    addRect(centerX + 80, centerY + 85, 10, textSize / 2);
 }
 
 /**
- * @brief Draw you win screen
+ * @brief Build the you win screen geometry
  */
-void Game::drawYouWin() {
-    if (!window) {
-        return;
-    }
+void Game::buildYouWinScreen() {
+    youWinScreen.clear();
+    youWinScreen.setPrimitiveType(sf::PrimitiveType::Triangles);
     
-    // Draw semi-transparent overlay
-    sf::RectangleShape overlay(sf::Vector2f(windowWidth, windowHeight));
-    overlay.setFillColor(sf::Color(0, 0, 0, 200));
-    window->draw(overlay);
+    // Semi-transparent overlay
+    appendRect(youWinScreen, 0, 0, windowWidth, windowHeight, sf::Color(0, 0, 0, 200));
     
-    // Draw "YOU WIN!" text using rectangles
+    // "YOU WIN!" text using rectangles
     int centerX = windowWidth / 2;
     int centerY = windowHeight / 2;
     int textSize = 50;
@@ -1032,12 +740,8 @@ void Game::drawYouWin() {
     int letterHeight = textSize;
     int letterSpacing = 15;
     
-    // Helper function to draw a rectangle
-    auto drawRect = [&](float x, float y, float w, float h) {
-        sf::RectangleShape rect(sf::Vector2f(w, h));
-        rect.setPosition(sf::Vector2f(x, y));
-        rect.setFillColor(sf::Color::Green);
-        window->draw(rect);
+    auto addRect = [&](float x, float y, float w, float h) {
+        appendRect(youWinScreen, x, y, w, h, sf::Color::Green);
     };
     
     // "YOU" - First line
@@ -1045,85 +749,139 @@ void Game::drawYouWin() {
     int startY = centerY - 60;
     
     // Y
-    drawRect(startX, startY, 8, letterHeight / 2);
-    drawRect(startX + letterWidth - 8, startY, 8, letterHeight / 2);
-    drawRect(startX + letterWidth / 2 - 4, startY + letterHeight / 2, 8, letterHeight / 2);
+    addRect(startX, startY, 8, letterHeight / 2);
+    addRect(startX + letterWidth - 8, startY, 8, letterHeight / 2);
+    addRect(startX + letterWidth / 2 - 4, startY + letterHeight / 2, 8, letterHeight / 2);
     
     startX += letterWidth + letterSpacing;
     
     // O
-    drawRect(startX, startY, 8, letterHeight);
-    drawRect(startX + letterWidth - 8, startY, 8, letterHeight);
-    drawRect(startX, startY, letterWidth, 8);
-    drawRect(startX, startY + letterHeight - 8, letterWidth, 8);
+    addRect(startX, startY, 8, letterHeight);
+    addRect(startX + letterWidth - 8, startY, 8, letterHeight);
+    addRect(startX, startY, letterWidth, 8);
+    addRect(startX, startY + letterHeight - 8, letterWidth, 8);
     
     startX += letterWidth + letterSpacing;
     
     // U
-    drawRect(startX, startY, 8, letterHeight);
-    drawRect(startX + letterWidth - 8, startY, 8, letterHeight);
-    drawRect(startX, startY + letterHeight - 8, letterWidth, 8);
+    addRect(startX, startY, 8, letterHeight);
+    addRect(startX + letterWidth - 8, startY, 8, letterHeight);
+    addRect(startX, startY + letterHeight - 8, letterWidth, 8);
     
     // "WIN!" - Second line
     startX = centerX - 100;
     startY = centerY + 20;
     
     // W
-    drawRect(startX, startY, 8, letterHeight);
-    drawRect(startX + letterWidth / 2 - 4, startY + letterHeight / 2, 8, letterHeight / 2);
-    drawRect(startX + letterWidth - 8, startY, 8, letterHeight);
+    addRect(startX, startY, 8, letterHeight);
+    addRect(startX + letterWidth / 2 - 4, startY + letterHeight / 2, 8, letterHeight / 2);
+    addRect(startX + letterWidth - 8, startY, 8, letterHeight);
     
     startX += letterWidth + letterSpacing;
     
     // I
-    drawRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight);
+    addRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight);
     
     startX += letterWidth + letterSpacing;
     
     // N
-    drawRect(startX, startY, 8, letterHeight);
-    drawRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight);
-    drawRect(startX + letterWidth - 8, startY, 8, letterHeight);
+    addRect(startX, startY, 8, letterHeight);
+    addRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight);
+    addRect(startX + letterWidth - 8, startY, 8, letterHeight);
     
     startX += letterWidth + letterSpacing;
     
     // !
-    drawRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight - 20);
-    drawRect(startX + letterWidth / 2 - 4, startY + letterHeight - 8, 8, 8);
+    addRect(startX + letterWidth / 2 - 4, startY, 8, letterHeight - 20);
+    addRect(startX + letterWidth / 2 - 4, startY + letterHeight - 8, 8, 8);
 }
 
+#ifdef BOMBERMAN_PROFILING
 /**
- * @brief Clean up resources
+ * @brief Draw the frame time graph of the profiler
+ * 
+ * One column per recent frame, stacked by zone, over a gray bar showing
+ * the whole frame time. The two white lines mark 16.7 ms and 33.3 ms.
  */
-void Game::cleanup() {
-    // Delete all bombs
-    for (Bomb* bomb : bombs) {
-        delete bomb;
-    }
-    bombs.clear();
+void Game::drawProfilerOverlay() {
+    static const sf::Color zoneColors[PROFILE_ZONE_COUNT] = {
+        sf::Color(255, 200, 0),     // EVENTS
+        sf::Color(0, 200, 255),     // INPUT
+        sf::Color(0, 255, 100),     // UPDATE
+        sf::Color(200, 0, 255),     // SNAPSHOT
+        sf::Color(255, 80, 80),     // RENDER
+        sf::Color(120, 120, 255)    // DISPLAY
+    };
     
-    // Delete all enemies
-    for (Enemy* enemy : enemies) {
-        delete enemy;
+    const float pixelsPerMillisecond = 4.0f;
+    const float graphHeight = 40.0f * pixelsPerMillisecond;
+    const float left = 10.0f;
+    const float bottom = windowHeight - 10.0f;
+    
+    Profiler::instance().getFrames(profilerFrames);
+    
+    profilerOverlay.clear();
+    profilerOverlay.setPrimitiveType(sf::PrimitiveType::Triangles);
+    appendRect(profilerOverlay, left, bottom - graphHeight, Profiler::FRAME_HISTORY, graphHeight,
+               sf::Color(0, 0, 0, 160));
+    
+    for (size_t i = 0; i < profilerFrames.size(); i++) {
+        const FrameSample& frame = profilerFrames[i];
+        float x = left + i;
+        
+        float height = std::min(frame.frameMicroseconds / 1000.0f * pixelsPerMillisecond, graphHeight);
+        appendRect(profilerOverlay, x, bottom - height, 1, height, sf::Color(90, 90, 90));
+        
+        float top = bottom;
+        for (int zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+            float zoneHeight = frame.zoneMicroseconds[zone] / 1000.0f * pixelsPerMillisecond;
+            zoneHeight = std::min(zoneHeight, top - (bottom - graphHeight));
+            top -= zoneHeight;
+            appendRect(profilerOverlay, x, top, 1, zoneHeight, zoneColors[zone]);
+        }
     }
-    enemies.clear();
     
-    // Delete all power-ups
-    for (PowerUp* powerUp : powerUps) {
-        delete powerUp;
+    // Frame budgets for 60 and 30 frames per second
+    for (float budget : {1000.0f / 60.0f, 1000.0f / 30.0f}) {
+        appendRect(profilerOverlay, left, bottom - budget * pixelsPerMillisecond,
+                   Profiler::FRAME_HISTORY, 1, sf::Color::White);
     }
-    powerUps.clear();
     
-    // Delete player
-    if (player) {
-        delete player;
-        player = nullptr;
+    window->draw(profilerOverlay);
+}
+#endif
+
+/**
+ * @brief Build the HUD geometry for a number of lives
+ * @param lives Lives to show
+ */
+void Game::buildHUD(int lives) {
+    hud.clear();
+    hud.setPrimitiveType(sf::PrimitiveType::Triangles);
+    hudLives = lives;
+    
+    // Lives indicator using simple shapes
+    int offsetX = 10;
+    int offsetY = 10;
+    
+    // One outlined square per life
+    for (int i = 0; i < lives; i++) {
+        appendRect(hud, offsetX + i * 25 - 1, offsetY - 1, 22, 22, sf::Color::White);
+        appendRect(hud, offsetX + i * 25, offsetY, 20, 20, sf::Color::Green);
     }
+}
+
+/**
+ * @brief Clean up resources
+ */
+void Game::cleanup() {
+    // The simulation thread must be gone before the match is deleted
+    stopSimulation();
     
-    // Delete map
-    if (map) {
-        delete map;
-        map = nullptr;
+    // Delete the match
+    if (simulation) {
+        delete simulation;
+        simulation = nullptr;
     }
     
     // Stop and cleanup audio
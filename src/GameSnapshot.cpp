@@ -0,0 +1,133 @@
+#include "../include/GameSnapshot.hpp"
+
+/**
+ * @brief Constructor for CellChangeLog
+ */
+CellChangeLog::CellChangeLog()
+    : published(0) {
+}
+
+/**
+ * @brief Add the cells changed by the last simulation step
+ * @param map Map right after the step
+ */
+void CellChangeLog::record(const Map& map) {
+    pendingFlags.resize(static_cast<size_t>(map.getWidth()) * map.getHeight(), 0);
+    
+    for (int index : map.getDirtyCells()) {
+        int cell = map.getIndexY(index) * map.getWidth() + map.getIndexX(index);
+        if (!pendingFlags[cell]) {
+            pendingFlags[cell] = 1;
+            pending.push_back(cell);
+        }
+    }
+}
+
+/**
+ * @brief Get the sequence number of the last published snapshot
+ * @return Sequence number, 0 before the first one
+ */
+std::uint64_t CellChangeLog::getPublished() const {
+    return published;
+}
+
+/**
+ * @brief Get the cells changed between a snapshot and the one before it
+ * @param sequence Sequence number, one of the last LENGTH published
+ * @return Row-major cell indices
+ */
+const std::vector<int>& CellChangeLog::getChanges(std::uint64_t sequence) const {
+    return history[sequence % LENGTH];
+}
+
+/**
+ * @brief Get the cells changed since the last published snapshot
+ * @return Row-major cell indices, each listed once
+ */
+const std::vector<int>& CellChangeLog::getPending() const {
+    return pending;
+}
+
+/**
+ * @brief File the pending changes under the next sequence number
+ */
+void CellChangeLog::publish() {
+    published++;
+    std::vector<int>& entry = history[published % LENGTH];
+    entry.swap(pending);
+    pending.clear();
+    for (int cell : entry) {
+        pendingFlags[cell] = 0;
+    }
+}
+
+/**
+ * @brief Copy the visible state of a simulation and number the snapshot
+ * @param simulation Simulation to copy
+ * @param changes Cells changed since the previous snapshots; the
+ * pending ones are published with this snapshot
+ */
+void GameSnapshot::capture(const Simulation& simulation, CellChangeLog& changes) {
+    const Map& map = simulation.getMap();
+    std::uint64_t published = changes.getPublished();
+    
+    tick = simulation.getTick();
+    mapWidth = map.getWidth();
+    mapHeight = map.getHeight();
+    
+    // A slot filled within the last LENGTH snapshots only needs the cells
+    // changed since; anything older is copied whole
+    std::size_t cellCount = static_cast<size_t>(mapWidth) * mapHeight;
+    if (sequence == 0 || published - sequence > CellChangeLog::LENGTH || cells.size() != cellCount) {
+        cells.resize(cellCount);
+        for (int y = 0; y < mapHeight; y++) {
+            for (int x = 0; x < mapWidth; x++) {
+                cells[y * mapWidth + x] = map.getCellUnchecked(x, y);
+            }
+        }
+    } else {
+        for (std::uint64_t missed = sequence + 1; missed <= published; missed++) {
+            for (int cell : changes.getChanges(missed)) {
+                cells[cell] = map.getCellUnchecked(cell % mapWidth, cell / mapWidth);
+            }
+        }
+        for (int cell : changes.getPending()) {
+            cells[cell] = map.getCellUnchecked(cell % mapWidth, cell / mapWidth);
+        }
+    }
+    
+    changedCells.assign(changes.getPending().begin(), changes.getPending().end());
+    changes.publish();
+    sequence = changes.getPublished();
+    
+    const Player& p = simulation.getPlayer();
+    player = {p.getX(), p.getY(), p.getPreviousX(), p.getPreviousY()};
+    playerAlive = p.isAlive();
+    lives = p.getLives();
+    
+    enemies.clear();
+    for (const Enemy* enemy : simulation.getEnemies()) {
+        if (enemy && enemy->isAlive()) {
+            enemies.push_back({enemy->getX(), enemy->getY(),
+                               enemy->getPreviousX(), enemy->getPreviousY()});
+        }
+    }
+    
+    bombs.clear();
+    for (const Bomb& bomb : simulation.getBombs()) {
+        bombs.push_back({bomb.getX(), bomb.getY(), bomb.getX(), bomb.getY()});
+    }
+    
+    powerUps.clear();
+    for (const PowerUp* powerUp : simulation.getPowerUps()) {
+        if (powerUp && !powerUp->isCollected()) {
+            powerUps.push_back({powerUp->getX(), powerUp->getY(), powerUp->getType()});
+        }
+    }
+    
+    gameOver = simulation.isGameOver();
+    victory = simulation.isVictory();
+    for (int i = 0; i < SIMULATION_EVENT_TYPES; i++) {
+        eventCounts[i] = simulation.getEventCount(static_cast<SimulationEvent>(i));
+    }
+}
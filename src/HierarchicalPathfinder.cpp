@@ -0,0 +1,252 @@
+#include "../include/HierarchicalPathfinder.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+/**
+ * @brief Order of the A* open list: lowest estimate first, and among
+ * equal estimates the node furthest along, which reaches the goal sooner
+ */
+struct LaterFirst {
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const {
+        return a.estimate > b.estimate || (a.estimate == b.estimate && a.cost < b.cost);
+    }
+};
+
+/**
+ * @brief Get the step from one cell to its neighbour
+ * @param from Padded index
+ * @param to Padded index of a neighbour
+ * @param stride Padded row length of the map
+ * @return 0=up, 1=down, 2=left, 3=right
+ */
+int stepDirection(int from, int to, int stride) {
+    int delta = to - from;
+    return delta == -stride ? 0 : delta == stride ? 1 : delta == -1 ? 2 : 3;
+}
+
+}
+
+/**
+ * @brief Constructor for HierarchicalPathfinder
+ */
+HierarchicalPathfinder::HierarchicalPathfinder()
+    : graph(nullptr), map(nullptr), goalX(0), goalY(0), expandedCount(0), generation(0) {
+}
+
+/**
+ * @brief Find a path between two cells
+ * @param graph Cluster graph of the map
+ * @param map Map the graph covers
+ * @param from Padded index of the start
+ * @param to Padded index of the goal
+ * @param firstDirection Output: 0=up, 1=down, 2=left, 3=right, -1 if no step
+ * @return Steps to the goal, or NO_PATH
+ */
+std::uint32_t HierarchicalPathfinder::findPath(const ClusterGraph& graph, const Map& map,
+                                               int from, int to, int& firstDirection) {
+    firstDirection = -1;
+    expandedCount = 0;
+    if (from == to) {
+        return 0;
+    }
+    
+    // Cells in separate areas would make the search flood a whole area
+    if (!graph.isConnected(from, to)) {
+        return NO_PATH;
+    }
+    
+    this->graph = &graph;
+    this->map = &map;
+    goalX = map.getIndexX(to);
+    goalY = map.getIndexY(to);
+    
+    const int size = graph.getClusterSize();
+    const int fromCluster = graph.getClusterOf(map.getIndexX(from), map.getIndexY(from));
+    const int toCluster = graph.getClusterOf(goalX, goalY);
+    int x0, y0, x1, y1;
+    
+    // Link both ends to the entrances of their clusters
+    searchCluster(graph, map, from, fromCluster, startDistance, &startOrigin);
+    searchCluster(graph, map, to, toCluster, goalDistance, nullptr);
+    
+    // A path that stays inside a shared cluster is a candidate too
+    std::uint32_t best = NO_PATH;
+    int bestDirection = -1;
+    if (fromCluster == toCluster) {
+        graph.getClusterBounds(toCluster, x0, y0, x1, y1);
+        int local = (goalY - y0) * size + (goalX - x0);
+        if (startDistance[local] != NOT_REACHED) {
+            best = startDistance[local];
+            bestDirection = startOrigin[local];
+        }
+    }
+    
+    if (costs.size() < graph.getNodeCapacity()) {
+        reserve(graph.getNodeCapacity());
+    }
+    if (++generation == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        generation = 1;
+    }
+    open.clear();
+    
+    graph.getClusterBounds(fromCluster, x0, y0, x1, y1);
+    for (int id : graph.getClusterNodes(fromCluster)) {
+        int cell = graph.getNode(id).cell;
+        int local = (map.getIndexY(cell) - y0) * size + (map.getIndexX(cell) - x0);
+        if (startDistance[local] != NOT_REACHED) {
+            relax(id, startDistance[local], startOrigin[local]);
+        }
+    }
+    
+    graph.getClusterBounds(toCluster, x0, y0, x1, y1);
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), LaterFirst());
+        OpenEntry entry = open.back();
+        open.pop_back();
+        
+        // Nothing left can beat the best by more than the estimate's slack
+        if (entry.estimate >= best) {
+            break;
+        }
+        if (entry.cost > costs[entry.node]) {
+            continue;
+        }
+        expandedCount++;
+        
+        const ClusterNode& node = graph.getNode(entry.node);
+        int direction = origins[entry.node];
+        
+        if (node.cluster == toCluster) {
+            int local = (map.getIndexY(node.cell) - y0) * size + (map.getIndexX(node.cell) - x0);
+            if (goalDistance[local] != NOT_REACHED && entry.cost + goalDistance[local] < best) {
+                best = entry.cost + goalDistance[local];
+                bestDirection = direction;
+            }
+        }
+        
+        // Through the entrance; the start itself may be an entrance cell
+        int crossing = direction >= 0 ? direction
+                                      : stepDirection(node.cell, graph.getNode(node.peer).cell, map.getStride());
+        relax(node.peer, entry.cost + 1, crossing);
+        
+        // To the other entrances of the cluster
+        const std::vector<int>& members = graph.getClusterNodes(node.cluster);
+        for (int slot = 0; slot < static_cast<int>(members.size()); slot++) {
+            std::uint16_t cost = graph.getCost(node.cluster, node.slot, slot);
+            if (slot != node.slot && cost != ClusterGraph::NO_PATH) {
+                relax(members[slot], entry.cost + cost, direction);
+            }
+        }
+    }
+    
+    this->graph = nullptr;
+    this->map = nullptr;
+    firstDirection = bestDirection;
+    return best;
+}
+
+/**
+ * @brief Size the per-node scratch space ahead of the first query
+ * @param nodeCapacity Node capacity of the graph to search
+ */
+void HierarchicalPathfinder::reserve(std::size_t nodeCapacity) {
+    // Growing takes milliseconds on a large graph; the spare room covers
+    // the entrances that destroyed blocks add later in the game
+    std::size_t size = nodeCapacity + (nodeCapacity >> HEADROOM_SHIFT);
+    if (costs.size() < size) {
+        costs.resize(size);
+        stamps.resize(size, 0);
+        origins.resize(size);
+    }
+}
+
+/**
+ * @brief Get the nodes expanded by the last query
+ * @return Node count
+ */
+int HierarchicalPathfinder::getExpandedCount() const {
+    return expandedCount;
+}
+
+/**
+ * @brief Walk a cluster from a cell, recording distances and first steps
+ * @param graph Cluster graph of the map
+ * @param map Map the graph covers
+ * @param cell Padded index to start from
+ * @param cluster Cluster of the cell
+ * @param distance Output, distance per local cell
+ * @param origin Output, first step per local cell (nullptr to skip)
+ */
+void HierarchicalPathfinder::searchCluster(const ClusterGraph& graph, const Map& map, int cell, int cluster,
+                                           std::vector<std::uint16_t>& distance, std::vector<std::int8_t>* origin) {
+    const int size = graph.getClusterSize();
+    const int stride = map.getStride();
+    const int offsets[4] = {-stride, stride, -1, 1};
+    const int localOffsets[4] = {-size, size, -1, 1};
+    int x0, y0, x1, y1;
+    graph.getClusterBounds(cluster, x0, y0, x1, y1);
+    
+    distance.assign(static_cast<std::size_t>(size) * size, NOT_REACHED);
+    if (origin) {
+        origin->resize(distance.size());
+    }
+    queue.clear();
+    
+    int startLocal = (map.getIndexY(cell) - y0) * size + (map.getIndexX(cell) - x0);
+    distance[startLocal] = 0;
+    if (origin) {
+        (*origin)[startLocal] = -1;
+    }
+    queue.push_back(cell);
+    
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        int index = queue[head];
+        int x = map.getIndexX(index);
+        int y = map.getIndexY(index);
+        int local = (y - y0) * size + (x - x0);
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + (dir == 2 ? -1 : dir == 3 ? 1 : 0);
+            int ny = y + (dir == 0 ? -1 : dir == 1 ? 1 : 0);
+            if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) {
+                continue;
+            }
+            int neighbourLocal = local + localOffsets[dir];
+            CellType type = map.getCellAt(index + offsets[dir]);
+            if (distance[neighbourLocal] == NOT_REACHED && type != CellType::WALL && type != CellType::BLOCK) {
+                distance[neighbourLocal] = static_cast<std::uint16_t>(distance[local] + 1);
+                if (origin) {
+                    (*origin)[neighbourLocal] = index == cell ? static_cast<std::int8_t>(dir) : (*origin)[local];
+                }
+                queue.push_back(index + offsets[dir]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Offer a node a new path
+ * @param node Node id
+ * @param cost Steps to the node
+ * @param direction First step of the path
+ */
+void HierarchicalPathfinder::relax(int node, std::uint32_t cost, int direction) {
+    if (stamps[node] == generation && costs[node] <= cost) {
+        return;
+    }
+    stamps[node] = generation;
+    costs[node] = cost;
+    origins[node] = static_cast<std::int8_t>(direction);
+    
+    // The estimate is inflated a little so that of the many near-equal
+    // routes across a grid only the ones heading for the goal get expanded
+    int cell = graph->getNode(node).cell;
+    std::uint32_t estimate = static_cast<std::uint32_t>(std::abs(map->getIndexX(cell) - goalX) +
+                                                        std::abs(map->getIndexY(cell) - goalY));
+    open.push_back(OpenEntry{cost + estimate + (estimate >> ESTIMATE_SHIFT), cost, node});
+    std::push_heap(open.begin(), open.end(), LaterFirst());
+}
@@ -0,0 +1,277 @@
+#include "../include/InputReplay.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char MAGIC[4] = {'B', 'M', 'R', 'P'};   ///< First bytes of a replay file
+
+}
+
+/**
+ * @brief Constructor for InputReplay
+ */
+InputReplay::InputReplay()
+    : tickCount(0), lastChangeTick(0), lastFlags(0),
+      readPosition(0), playTick(0), currentFlags(0),
+      hasChange(false), changeTick(0), changeFlags(0) {
+}
+
+/**
+ * @brief Discard any content and start recording a new match
+ * @param header Settings of the match being recorded
+ */
+void InputReplay::startRecording(const ReplayHeader& header) {
+    this->header = header;
+    changes.clear();
+    tickCount = 0;
+    lastChangeTick = 0;
+    lastFlags = 0;
+    rewind();
+}
+
+/**
+ * @brief Append the input of the next tick
+ * @param input Input passed to Simulation::step
+ */
+void InputReplay::record(const SimulationInput& input) {
+    std::uint8_t flags = encodeFlags(input);
+    if (flags != lastFlags) {
+        writeVarint(changes, ((tickCount - lastChangeTick) << FLAG_BITS) | flags);
+        lastChangeTick = tickCount;
+        lastFlags = flags;
+    }
+    tickCount++;
+}
+
+/**
+ * @brief Write the recording to a file
+ * @param path Output file
+ * @return True if the file was written
+ */
+bool InputReplay::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    
+    std::vector<std::uint8_t> fileHeader(MAGIC, MAGIC + sizeof(MAGIC));
+    writeVarint(fileHeader, FORMAT_VERSION);
+    writeVarint(fileHeader, header.seed);
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.tickRate));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.mapWidth));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.mapHeight));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.enemyCount));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.enemyAi));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.searchBudget.microseconds));
+    writeVarint(fileHeader, static_cast<std::uint64_t>(header.searchBudget.nodesPerEnemy));
+    writeVarint(fileHeader, tickCount);
+    writeVarint(fileHeader, changes.size());
+    
+    out.write(reinterpret_cast<const char*>(fileHeader.data()), fileHeader.size());
+    out.write(reinterpret_cast<const char*>(changes.data()), changes.size());
+    
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Read a recording from a file and rewind it for playback
+ * @param path Input file
+ * @return True if the file was a valid recording
+ */
+bool InputReplay::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(MAGIC) || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), bytes.begin())) {
+        return false;
+    }
+    
+    std::size_t position = sizeof(MAGIC);
+    std::uint64_t version;
+    // Older versions were recorded with enemies drawing from one shared
+    // random stream, so their matches can no longer be reproduced
+    if (!readVarint(bytes, position, version) || version != FORMAT_VERSION) {
+        return false;
+    }
+    
+    std::uint64_t fields[10];
+    for (int i = 0; i < 10; i++) {
+        if (!readVarint(bytes, position, fields[i])) {
+            return false;
+        }
+    }
+    
+    // Reject settings the Simulation would not accept
+    if (fields[0] > UINT32_MAX ||
+        fields[1] == 0 || fields[1] > 10000 ||
+        fields[2] < 5 || fields[2] > 4096 || fields[3] < 5 || fields[3] > 4096 ||
+        fields[4] > 100000 || fields[5] > static_cast<std::uint64_t>(EnemyAi::SEARCH) ||
+        fields[6] > 10000000 || fields[7] > 10000000 ||
+        fields[9] != bytes.size() - position) {
+        return false;
+    }
+    
+    header.seed = static_cast<std::uint32_t>(fields[0]);
+    header.tickRate = static_cast<int>(fields[1]);
+    header.mapWidth = static_cast<int>(fields[2]);
+    header.mapHeight = static_cast<int>(fields[3]);
+    header.enemyCount = static_cast<int>(fields[4]);
+    header.enemyAi = static_cast<EnemyAi>(fields[5]);
+    header.searchBudget.microseconds = static_cast<int>(fields[6]);
+    header.searchBudget.nodesPerEnemy = static_cast<int>(fields[7]);
+    tickCount = fields[8];
+    changes.assign(bytes.begin() + position, bytes.end());
+    
+    // Further recording appends after the loaded ticks
+    lastChangeTick = 0;
+    lastFlags = 0;
+    rewind();
+    while (hasChange) {
+        lastChangeTick = changeTick;
+        lastFlags = changeFlags;
+        fetchChange();
+    }
+    
+    rewind();
+    return true;
+}
+
+/**
+ * @brief Restart playback from the first tick
+ */
+void InputReplay::rewind() {
+    readPosition = 0;
+    playTick = 0;
+    currentFlags = 0;
+    changeTick = 0;
+    fetchChange();
+}
+
+/**
+ * @brief Get the input of the next tick
+ * @param input Output input
+ * @return False once every recorded tick has been played
+ */
+bool InputReplay::next(SimulationInput& input) {
+    if (playTick >= tickCount) {
+        return false;
+    }
+    
+    if (hasChange && changeTick == playTick) {
+        currentFlags = changeFlags;
+        fetchChange();
+    }
+    
+    input = decodeFlags(currentFlags);
+    playTick++;
+    return true;
+}
+
+/**
+ * @brief Get the match settings
+ * @return Header
+ */
+const ReplayHeader& InputReplay::getHeader() const {
+    return header;
+}
+
+/**
+ * @brief Get the number of recorded ticks
+ * @return Tick count
+ */
+std::uint64_t InputReplay::getTickCount() const {
+    return tickCount;
+}
+
+/**
+ * @brief Get the size of the encoded input
+ * @return Bytes in the change stream
+ */
+std::size_t InputReplay::getByteCount() const {
+    return changes.size();
+}
+
+/**
+ * @brief Pack an input into flag bits
+ * @param input Input to pack
+ * @return Flags (up, down, left, right, bomb from bit 0)
+ */
+std::uint8_t InputReplay::encodeFlags(const SimulationInput& input) {
+    return static_cast<std::uint8_t>((input.moveUp ? 0x01 : 0) |
+                                     (input.moveDown ? 0x02 : 0) |
+                                     (input.moveLeft ? 0x04 : 0) |
+                                     (input.moveRight ? 0x08 : 0) |
+                                     (input.placeBomb ? 0x10 : 0));
+}
+
+/**
+ * @brief Unpack flag bits into an input
+ * @param flags Packed flags
+ * @return Input
+ */
+SimulationInput InputReplay::decodeFlags(std::uint8_t flags) {
+    SimulationInput input;
+    input.moveUp = (flags & 0x01) != 0;
+    input.moveDown = (flags & 0x02) != 0;
+    input.moveLeft = (flags & 0x04) != 0;
+    input.moveRight = (flags & 0x08) != 0;
+    input.placeBomb = (flags & 0x10) != 0;
+    return input;
+}
+
+/**
+ * @brief Append a varint to a byte buffer
+ * @param out Buffer
+ * @param value Value to encode
+ */
+void InputReplay::writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    // Seven bits per byte, least significant first; the high bit marks
+    // that another byte follows
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Decode a varint from a byte buffer
+ * @param in Buffer
+ * @param position Read position, advanced past the varint
+ * @param value Decoded value
+ * @return False if the buffer ends inside the varint or it is too long
+ */
+bool InputReplay::readVarint(const std::vector<std::uint8_t>& in, std::size_t& position,
+                             std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= in.size()) {
+            return false;
+        }
+        
+        std::uint8_t byte = in[position++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Decode the next change of the stream, if any
+ */
+void InputReplay::fetchChange() {
+    std::uint64_t value = 0;
+    hasChange = readVarint(changes, readPosition, value);
+    if (hasChange) {
+        changeTick += value >> FLAG_BITS;
+        changeFlags = static_cast<std::uint8_t>(value & ((1u << FLAG_BITS) - 1));
+    }
+}
@@ -6,11 +6,14 @@
  * @param width Width of the map in cells
  * @param height Height of the map in cells
  */
-Map::Map(int width, int height) : width(width), height(height) {
-    // Initialize grid with empty cells
-    grid.resize(height);
-    for (int i = 0; i < height; i++) {
-        grid[i].resize(width, CellType::EMPTY);
+Map::Map(int width, int height)
+    : width(width), height(height), stride(width + 2), activeHead(0) {
+    // Initialize grid with empty cells inside a border of sentinel walls
+    cells.assign(static_cast<size_t>(stride) * (height + 2), CellType::WALL);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            cells[getIndex(x, y)] = CellType::EMPTY;
+        }
     }
     
     initialize();
@@ -48,7 +51,7 @@ CellType Map::getCell(int x, int y) const {
     if (!isValidPosition(x, y)) {
         return CellType::WALL;
     }
-    return grid[y][x];
+    return cells[getIndex(x, y)];
 }
 
 /**
@@ -59,7 +62,7 @@ CellType Map::getCell(int x, int y) const {
  */
 void Map::setCell(int x, int y, CellType type) {
     if (isValidPosition(x, y)) {
-        grid[y][x] = type;
+        writeCell(getIndex(x, y), type);
     }
 }
 
@@ -74,8 +77,7 @@ bool Map::isWalkable(int x, int y) const {
         return false;
     }
     
-    CellType cell = getCell(x, y);
-    return cell == CellType::EMPTY || cell == CellType::EXPLOSION;
+    return isWalkableUnchecked(x, y);
 }
 
 /**
@@ -89,61 +91,142 @@ bool Map::isValidPosition(int x, int y) const {
 }
 
 /**
- * @brief Create an explosion at a position
- * @param x X coordinate
- * @param y Y coordinate
- * @param range Explosion range
+ * @brief Get the distance between vertically adjacent cells in the buffer
+ * @return Row stride (width + 2)
  */
-void Map::createExplosion(int x, int y, int range) {
-    // Center explosion
-    if (isValidPosition(x, y)) {
-        CellType cell = getCell(x, y);
-        if (cell == CellType::BLOCK) {
-            setCell(x, y, CellType::EMPTY);
-        } else if (cell != CellType::WALL) {
-            setCell(x, y, CellType::EXPLOSION);
+int Map::getStride() const {
+    return stride;
+}
+
+/**
+ * @brief Set a cell on fire until a given tick
+ * @param index Padded buffer index of a non-wall cell
+ * @param expiryTick Tick on which the explosion disappears
+ */
+void Map::igniteCell(int index, std::uint64_t expiryTick) {
+    writeCell(index, CellType::EXPLOSION);
+    explosionExpiry[index] = expiryTick;
+    activeExplosions.push_back({expiryTick, index});
+}
+
+/**
+ * @brief Put out the explosions whose lifetime has ended
+ * @param tick Current tick
+ */
+void Map::expireExplosions(std::uint64_t tick) {
+    while (activeHead < activeExplosions.size() &&
+           activeExplosions[activeHead].expiryTick <= tick) {
+        const ExplosionTimer& timer = activeExplosions[activeHead];
+        
+        // A later ignition of the same cell leaves this entry stale
+        if (explosionExpiry[timer.index] == timer.expiryTick &&
+            cells[timer.index] == CellType::EXPLOSION) {
+            writeCell(timer.index, CellType::EMPTY);
         }
+        activeHead++;
     }
     
-    // Explosion in four directions
-    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    // Reclaim the consumed prefix once it dominates the list
+    if (activeHead == activeExplosions.size()) {
+        activeExplosions.clear();
+        activeHead = 0;
+    } else if (activeHead > activeExplosions.size() / 2) {
+        activeExplosions.erase(activeExplosions.begin(), activeExplosions.begin() + activeHead);
+        activeHead = 0;
+    }
+}
+
+/**
+ * @brief Get the number of pending explosion expiries
+ * @return Entries in the active explosion list
+ */
+std::size_t Map::getActiveExplosionCount() const {
+    return activeExplosions.size() - activeHead;
+}
+
+/**
+ * @brief Get the tick on which a burning cell goes out
+ * @param index Padded buffer index of an EXPLOSION cell
+ * @return Expiry tick
+ */
+std::uint64_t Map::getExplosionExpiry(int index) const {
+    return explosionExpiry[index];
+}
+
+/**
+ * @brief Replace the blocks and put out every explosion
+ * @param blockWords Block plane in the layout of getBlockBits()
+ */
+void Map::restoreBlocks(const std::uint64_t* blockWords) {
+    activeExplosions.clear();
+    activeHead = 0;
     
-    for (int dir = 0; dir < 4; dir++) {
-        for (int r = 1; r <= range; r++) {
-            int newX = x + directions[dir][0] * r;
-            int newY = y + directions[dir][1] * r;
-            
-            if (!isValidPosition(newX, newY)) {
-                break;
-            }
-            
-            CellType cell = getCell(newX, newY);
-            
-            // Stop explosion at walls
-            if (cell == CellType::WALL) {
-                break;
-            }
-            
-            // Destroy blocks and create explosion
-            if (cell == CellType::BLOCK) {
-                setCell(newX, newY, CellType::EMPTY);
-                break; // Stop explosion after destroying block
-            } else {
-                setCell(newX, newY, CellType::EXPLOSION);
-            }
+    // The border and the pillars are walls on every map, so they stay
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (cells[i] == CellType::WALL) {
+            continue;
         }
+        bool block = (blockWords[i >> 6] >> (i & 63)) & 1;
+        writeCell(static_cast<int>(i), block ? CellType::BLOCK : CellType::EMPTY);
     }
 }
 
 /**
- * @brief Remove explosion effects from the map
+ * @brief Get the cells whose type changed since the last clearDirtyCells()
+ * @return Padded buffer indices, each listed once
  */
-void Map::clearExplosions() {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (grid[y][x] == CellType::EXPLOSION) {
-                grid[y][x] = CellType::EMPTY;
-            }
+const std::vector<int>& Map::getDirtyCells() const {
+    return dirtyCells;
+}
+
+/**
+ * @brief Forget the recorded cell changes
+ */
+void Map::clearDirtyCells() {
+    for (int index : dirtyCells) {
+        dirtyFlags[index] = 0;
+    }
+    dirtyCells.clear();
+}
+
+/**
+ * @brief Get the destructible block plane
+ * @return Bitboard with a bit per BLOCK cell
+ */
+const Bitboard& Map::getBlockBits() const {
+    return blockBits;
+}
+
+/**
+ * @brief Get the explosion plane
+ * @return Bitboard with a bit per EXPLOSION cell
+ */
+const Bitboard& Map::getExplosionBits() const {
+    return explosionBits;
+}
+
+/**
+ * @brief Rebuild every bit plane from the cell buffer
+ */
+void Map::rebuildBits() {
+    blockBits.resize(cells.size());
+    explosionBits.resize(cells.size());
+    explosionExpiry.assign(cells.size(), 0);
+    dirtyFlags.assign(cells.size(), 0);
+    dirtyCells.clear();
+    dirtyCells.reserve(cells.size());
+    
+    for (size_t i = 0; i < cells.size(); i++) {
+        switch (cells[i]) {
+            case CellType::BLOCK:
+                blockBits.set(i);
+                break;
+            case CellType::EXPLOSION:
+                explosionBits.set(i);
+                break;
+            case CellType::EMPTY:
+            case CellType::WALL:
+                break;
         }
     }
 }
@@ -154,18 +237,18 @@ void Map::clearExplosions() {
 void Map::initialize() {
     // Create border walls
     for (int x = 0; x < width; x++) {
-        grid[0][x] = CellType::WALL;
-        grid[height - 1][x] = CellType::WALL;
+        cells[getIndex(x, 0)] = CellType::WALL;
+        cells[getIndex(x, height - 1)] = CellType::WALL;
     }
     for (int y = 0; y < height; y++) {
-        grid[y][0] = CellType::WALL;
-        grid[y][width - 1] = CellType::WALL;
+        cells[getIndex(0, y)] = CellType::WALL;
+        cells[getIndex(width - 1, y)] = CellType::WALL;
     }
     
     // Create internal walls in a grid pattern
     for (int y = 2; y < height - 1; y += 2) {
         for (int x = 2; x < width - 1; x += 2) {
-            grid[y][x] = CellType::WALL;
+            cells[getIndex(x, y)] = CellType::WALL;
         }
     }
     
@@ -173,10 +256,10 @@ void Map::initialize() {
     for (int y = 1; y < height - 1; y++) {
         for (int x = 1; x < width - 1; x++) {
             // Don't place blocks on walls or in starting positions
-            if (grid[y][x] == CellType::EMPTY && !shouldBeWall(x, y)) {
+            if (cells[getIndex(x, y)] == CellType::EMPTY && !shouldBeWall(x, y)) {
                 // Randomly place blocks (about 30% chance)
                 if ((x + y) % 3 == 0 && (x * y) % 5 != 0) {
-                    grid[y][x] = CellType::BLOCK;
+                    cells[getIndex(x, y)] = CellType::BLOCK;
                 }
             }
         }
@@ -184,9 +267,9 @@ void Map::initialize() {
     
     // Ensure starting positions are clear (corners)
     // Player starting position (top-left)
-    grid[1][1] = CellType::EMPTY;
-    grid[1][2] = CellType::EMPTY;
-    grid[2][1] = CellType::EMPTY;
+    cells[getIndex(1, 1)] = CellType::EMPTY;
+    cells[getIndex(2, 1)] = CellType::EMPTY;
+    cells[getIndex(1, 2)] = CellType::EMPTY;
     
     // Enemy starting positions - clear area around each enemy
     // Top-right enemy (mapWidth - 2, 1)
@@ -196,8 +279,8 @@ void Map::initialize() {
         for (int dx = -2; dx <= 0; dx++) {
             int x = enemy1X + dx;
             int y = enemy1Y + dy;
-            if (isValidPosition(x, y) && grid[y][x] != CellType::WALL) {
-                grid[y][x] = CellType::EMPTY;
+            if (isValidPosition(x, y) && cells[getIndex(x, y)] != CellType::WALL) {
+                cells[getIndex(x, y)] = CellType::EMPTY;
             }
         }
     }
@@ -209,8 +292,8 @@ void Map::initialize() {
         for (int dx = -1; dx <= 2; dx++) {
             int x = enemy2X + dx;
             int y = enemy2Y + dy;
-            if (isValidPosition(x, y) && grid[y][x] != CellType::WALL) {
-                grid[y][x] = CellType::EMPTY;
+            if (isValidPosition(x, y) && cells[getIndex(x, y)] != CellType::WALL) {
+                cells[getIndex(x, y)] = CellType::EMPTY;
             }
         }
     }
@@ -222,11 +305,14 @@ void Map::initialize() {
         for (int dx = -2; dx <= 0; dx++) {
             int x = enemy3X + dx;
             int y = enemy3Y + dy;
-            if (isValidPosition(x, y) && grid[y][x] != CellType::WALL) {
-                grid[y][x] = CellType::EMPTY;
+            if (isValidPosition(x, y) && cells[getIndex(x, y)] != CellType::WALL) {
+                cells[getIndex(x, y)] = CellType::EMPTY;
             }
         }
     }
+    
+    // Derive the bit planes from the finished layout
+    rebuildBits();
 }
 
 /**
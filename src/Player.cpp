@@ -1,4 +1,5 @@
 #include "../include/Player.hpp"
+#include "../include/GameState.hpp"
 
 /**
  * @brief Constructor for Player
@@ -6,7 +7,7 @@
  * @param startY Initial Y position on the map
  */
 Player::Player(int startX, int startY) 
-    : x(startX), y(startY), startX(startX), startY(startY), 
+    : x(startX), y(startY), prevX(startX), prevY(startY), startX(startX), startY(startY), 
       alive(true), lives(3), bombCount(1), maxBombs(1), bombRange(2) {
 }
 
@@ -32,6 +33,30 @@ int Player::getY() const {
     return y;
 }
 
+/**
+ * @brief Get the X position at the start of the current tick
+ * @return Previous X coordinate
+ */
+int Player::getPreviousX() const {
+    return prevX;
+}
+
+/**
+ * @brief Get the Y position at the start of the current tick
+ * @return Previous Y coordinate
+ */
+int Player::getPreviousY() const {
+    return prevY;
+}
+
+/**
+ * @brief Remember the current position as the previous one (start of a tick)
+ */
+void Player::storePreviousPosition() {
+    prevX = x;
+    prevY = y;
+}
+
 /**
  * @brief Move the player up
  */
@@ -93,8 +118,10 @@ void Player::respawn(int startX, int startY) {
     this->startY = startY;
     x = startX;
     y = startY;
+    prevX = startX;     // Teleport, do not slide across the map
+    prevY = startY;
     alive = true;
-    bombCount = maxBombs; // Reset bomb count
+    // Bombs still on the map come back to the player when they explode
 }
 
 /**
@@ -161,7 +188,7 @@ void Player::addLife() {
  */
 void Player::increaseMaxBombs() {
     maxBombs++;
-    bombCount = maxBombs; // Refill bomb count
+    bombCount++; // The new bomb is available right away
 }
 
 /**
@@ -187,3 +214,38 @@ void Player::increaseBombRange() {
     bombRange++;
 }
 
+/**
+ * @brief Copy the player into a packed state
+ * @param state Output state
+ */
+void Player::saveState(PlayerState& state) const {
+    state.x = static_cast<std::int16_t>(x);
+    state.y = static_cast<std::int16_t>(y);
+    state.prevX = static_cast<std::int16_t>(prevX);
+    state.prevY = static_cast<std::int16_t>(prevY);
+    state.startX = static_cast<std::int16_t>(startX);
+    state.startY = static_cast<std::int16_t>(startY);
+    state.lives = static_cast<std::int16_t>(lives);
+    state.bombCount = static_cast<std::int16_t>(bombCount);
+    state.maxBombs = static_cast<std::int16_t>(maxBombs);
+    state.bombRange = static_cast<std::int16_t>(bombRange);
+    state.alive = alive;
+}
+
+/**
+ * @brief Overwrite the player with a packed state
+ * @param state Saved state
+ */
+void Player::restoreState(const PlayerState& state) {
+    x = state.x;
+    y = state.y;
+    prevX = state.prevX;
+    prevY = state.prevY;
+    startX = state.startX;
+    startY = state.startY;
+    lives = state.lives;
+    bombCount = state.bombCount;
+    maxBombs = state.maxBombs;
+    bombRange = state.bombRange;
+    alive = state.alive;
+}
@@ -0,0 +1,135 @@
+#include "../include/Profiler.hpp"
+#include <atomic>
+#include <fstream>
+
+/**
+ * @brief Get the process-wide profiler
+ * @return Profiler instance
+ */
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief Constructor for Profiler
+ */
+Profiler::Profiler()
+    : epoch(std::chrono::steady_clock::now()), frameStart(0), frameCount(0),
+      trace(TRACE_CAPACITY), traceCount(0) {
+}
+
+/**
+ * @brief Get the current profiler time
+ * @return Microseconds since the profiler was created
+ */
+std::int64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+/**
+ * @brief Close the current frame sample and start the next one
+ */
+void Profiler::beginFrame() {
+    std::int64_t time = now();
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    current.frameMicroseconds = time - frameStart;
+    frames[frameCount % FRAME_HISTORY] = current;
+    frameCount++;
+    
+    current = FrameSample();
+    frameStart = time;
+}
+
+/**
+ * @brief Record a finished zone
+ * @param zone Zone that was timed
+ * @param start Start time from now()
+ * @param end End time from now()
+ */
+void Profiler::record(ProfileZone zone, std::int64_t start, std::int64_t end) {
+    std::uint32_t thread = getThreadIndex();
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    current.zoneMicroseconds[static_cast<int>(zone)] += end - start;
+    trace[traceCount % TRACE_CAPACITY] = {start, end - start, thread, zone};
+    traceCount++;
+}
+
+/**
+ * @brief Copy the recent frame samples, oldest first
+ * @param out Output samples
+ */
+void Profiler::getFrames(std::vector<FrameSample>& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    std::size_t count = frameCount < FRAME_HISTORY ? frameCount : FRAME_HISTORY;
+    out.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = frames[(frameCount - count + i) % FRAME_HISTORY];
+    }
+}
+
+/**
+ * @brief Write the recorded zones as Chrome trace-event JSON
+ * @param path Output file
+ * @return True if the file was written
+ */
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    // Complete ("X") events; timestamps are already in microseconds
+    out << "{\"traceEvents\":[\n";
+    std::size_t count = traceCount < TRACE_CAPACITY ? traceCount : TRACE_CAPACITY;
+    for (std::size_t i = 0; i < count; i++) {
+        const TraceEvent& event = trace[(traceCount - count + i) % TRACE_CAPACITY];
+        out << "{\"name\":\"" << getZoneName(event.zone)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << event.start
+            << ",\"dur\":" << event.duration << "}"
+            << (i + 1 < count ? ",\n" : "\n");
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+    
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Get the display name of a zone
+ * @param zone Zone
+ * @return Zone name
+ */
+const char* Profiler::getZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::EVENTS:
+            return "events";
+        case ProfileZone::INPUT:
+            return "processInput";
+        case ProfileZone::UPDATE:
+            return "update";
+        case ProfileZone::SNAPSHOT:
+            return "snapshot";
+        case ProfileZone::RENDER:
+            return "render";
+        case ProfileZone::DISPLAY:
+            return "display";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Get a small index identifying the calling thread
+ * @return Thread index, starting at 1
+ */
+std::uint32_t Profiler::getThreadIndex() {
+    static std::atomic<std::uint32_t> nextIndex(1);
+    thread_local std::uint32_t index = nextIndex.fetch_add(1);
+    return index;
+}
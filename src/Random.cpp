@@ -0,0 +1,87 @@
+#include "../include/Random.hpp"
+
+/**
+ * @brief Constructor for Random
+ * @param seed Seed; any value, including 0, is fine
+ * @param stream Independent stream of the seed to use
+ */
+Random::Random(std::uint64_t seed, std::uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+/**
+ * @brief Restart the generator from a seed
+ * @param seed Seed; any value, including 0, is fine
+ * @param stream Independent stream of the seed to use
+ */
+void Random::seed(std::uint64_t seed, std::uint64_t stream) {
+    // Expand the seed with splitmix64, which never yields an all-zero state
+    std::uint64_t x = seed;
+    for (std::uint64_t& word : state) {
+        x += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        word = z ^ (z >> 31);
+    }
+
+    for (std::uint64_t i = 0; i < stream; i++) {
+        jump();
+    }
+}
+
+/**
+ * @brief Fill a buffer with random 64-bit values
+ * @param out Output values
+ * @param count Number of values
+ */
+void Random::fill(std::uint64_t* out, std::size_t count) {
+    // Work on a local copy so the state stays in registers for the loop
+    Random local = *this;
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = local.next();
+    }
+    *this = local;
+}
+
+/**
+ * @brief Fill a buffer with random integers below a bound
+ * @param out Output values
+ * @param count Number of values
+ * @param bound Exclusive upper bound, greater than 0
+ */
+void Random::fillBelow(int* out, std::size_t count, std::uint32_t bound) {
+    Random local = *this;
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = static_cast<int>(local.nextBelow(bound));
+    }
+    *this = local;
+}
+
+/**
+ * @brief Advance the state by 2^128 numbers
+ */
+void Random::jump() {
+    static const std::uint64_t JUMP[4] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+        0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+    };
+
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : JUMP) {
+        for (int bit = 0; bit < 64; bit++) {
+            if (word & (1ull << bit)) {
+                jumped[0] ^= state[0];
+                jumped[1] ^= state[1];
+                jumped[2] ^= state[2];
+                jumped[3] ^= state[3];
+            }
+            next();
+        }
+    }
+
+    state[0] = jumped[0];
+    state[1] = jumped[1];
+    state[2] = jumped[2];
+    state[3] = jumped[3];
+}
@@ -0,0 +1,1142 @@
+#include "../include/Simulation.hpp"
+#include "../include/GameState.hpp"
+#include "../include/TickScheduler.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Constructor for Simulation
+ * @param mapWidth Map width in cells
+ * @param mapHeight Map height in cells
+ * @param tickRate Simulation ticks per second
+ * @param enemyCount Number of enemies (three start in the corners,
+ *                   any others spread over the free cells)
+ * @param seed Seed of the random number generator; the same seed and
+ *             inputs always produce the same match
+ */
+Simulation::Simulation(int mapWidth, int mapHeight, int tickRate, int enemyCount, std::uint32_t seed)
+    : player(nullptr), map(nullptr),
+      workers(nullptr), searches(1), pathfinders(1), moveClaimGeneration(0), thinkersLeft(0),
+      enemyAi(EnemyAi::STANDARD), searchFallbacks(0),
+      mapWidth(mapWidth), mapHeight(mapHeight),
+      tickRate(tickRate > 0 ? tickRate : 60), seed(seed),
+      aiRandom(seed, ENEMY_AI_STREAM), lootRandom(seed, LOOT_STREAM), tick(0),
+      gameOver(false), youWin(false),
+      moveDelay(TickScheduler::secondsToTicks(0.15f, this->tickRate)),
+      enemyMoveDelay(TickScheduler::secondsToTicks(0.3f, this->tickRate)),
+      enemyBombDelay(TickScheduler::secondsToTicks(2.0f, this->tickRate)),
+      bombFuse(TickScheduler::secondsToTicks(3.0f, this->tickRate)),
+      explosionDuration(TickScheduler::secondsToTicks(0.5f, this->tickRate)),
+      moveTimer(0), enemyMoveTimer(0),
+      playerStartX(1), playerStartY(1) {
+    eventCounts.fill(0);
+    
+    // Create map
+    map = new Map(mapWidth, mapHeight);
+    
+    // One occupancy slot per map cell, laid out like the map buffer. A cell
+    // holds at most one bomb, so the map area bounds the pool size and
+    // nothing is allocated when bombs are placed or explode.
+    bombGrid.assign(static_cast<size_t>(map->getStride()) * (mapHeight + 2), BombPool::INVALID_HANDLE);
+    bombs.reset(static_cast<size_t>(mapWidth) * mapHeight);
+    flowField.reset(bombGrid.size(), map->getStride());
+    dangerMap.reset(bombGrid.size(), map->getStride());
+    moveClaims.assign(bombGrid.size(), 0);
+    
+    // On large maps a flow field sweep over the whole map is too slow to
+    // redo every time the player moves. The field stops at a radius, and
+    // enemies beyond it find their way over the cluster graph instead.
+    if (static_cast<long>(mapWidth) * mapHeight >= HIERARCHY_MIN_CELLS) {
+        flowField.setMaxDistance(FLOW_FIELD_RADIUS);
+        clusterGraph.build(*map, CLUSTER_SIZE);
+        pathfinders[0].reserve(clusterGraph.getNodeCapacity());
+    }
+    
+    // One wheel revolution covers a full fuse, so every slot visit fires
+    fuseWheel.reset(static_cast<size_t>(bombFuse) + 1, bombs.capacity());
+    bombsToRemove.reserve(bombs.capacity());
+    
+    // Blast buffers are sized for the worst case so cascades never allocate
+    blastResolver.reset(bombGrid.size(), bombs.capacity());
+    blast.cells.reserve(bombGrid.size());
+    blast.destroyedBlocks.reserve(bombGrid.size());
+    blast.detonated.reserve(bombs.capacity());
+    
+    // Create player at starting position
+    player = new Player(playerStartX, playerStartY);
+    
+    spawnEnemies(enemyCount);
+}
+
+/**
+ * @brief Destructor
+ */
+Simulation::~Simulation() {
+    // Delete all enemies
+    for (Enemy* enemy : enemies) {
+        delete enemy;
+    }
+    enemies.clear();
+    
+    // Delete all power-ups
+    for (PowerUp* powerUp : powerUps) {
+        delete powerUp;
+    }
+    powerUps.clear();
+    
+    delete player;
+    player = nullptr;
+    
+    delete map;
+    map = nullptr;
+    
+    delete workers;
+    workers = nullptr;
+}
+
+/**
+ * @brief Advance the match by one tick
+ * @param input Player commands for this tick
+ */
+void Simulation::step(const SimulationInput& input) {
+    events.clear();
+    map->clearDirtyCells();
+    
+    // Positions at the start of the tick, for render interpolation
+    player->storePreviousPosition();
+    for (Enemy* enemy : enemies) {
+        enemy->storePreviousPosition();
+    }
+    
+    if (gameOver || youWin) {
+        return;
+    }
+    
+    tick++;
+    
+    if (input.placeBomb) {
+        placePlayerBomb();
+    }
+    
+    processInput(input);
+    update();
+}
+
+/**
+ * @brief Get the number of ticks simulated so far
+ * @return Current tick
+ */
+std::uint64_t Simulation::getTick() const {
+    return tick;
+}
+
+/**
+ * @brief Get the tick rate
+ * @return Simulation ticks per second
+ */
+int Simulation::getTickRate() const {
+    return tickRate;
+}
+
+/**
+ * @brief Get the seed the match was created with
+ * @return Random seed
+ */
+std::uint32_t Simulation::getSeed() const {
+    return seed;
+}
+
+/**
+ * @brief Get the game map
+ * 
+ * Map::getDirtyCells() lists the cells changed by the last step.
+ * 
+ * @return Map reference
+ */
+const Map& Simulation::getMap() const {
+    return *map;
+}
+
+/**
+ * @brief Get the player
+ * @return Player reference
+ */
+const Player& Simulation::getPlayer() const {
+    return *player;
+}
+
+/**
+ * @brief Get the enemies
+ * @return List of enemies
+ */
+const std::vector<Enemy*>& Simulation::getEnemies() const {
+    return enemies;
+}
+
+/**
+ * @brief Get the active bombs
+ * @return Pool of bombs (iterable)
+ */
+const BombPool& Simulation::getBombs() const {
+    return bombs;
+}
+
+/**
+ * @brief Get the power-ups on the map
+ * @return List of power-ups
+ */
+const std::vector<PowerUp*>& Simulation::getPowerUps() const {
+    return powerUps;
+}
+
+/**
+ * @brief Get the bomb at a position in O(1)
+ * @param x X coordinate in [-1, mapWidth]
+ * @param y Y coordinate in [-1, mapHeight]
+ * @return Bomb at the position, or nullptr if there is none
+ */
+const Bomb* Simulation::getBombAt(int x, int y) const {
+    BombPool::Handle handle = bombGrid[map->getIndex(x, y)];
+    if (handle == BombPool::INVALID_HANDLE) {
+        return nullptr;
+    }
+    return &bombs.get(handle);
+}
+
+/**
+ * @brief Check if a bomb occupies a position
+ * @param x X coordinate in [-1, mapWidth]
+ * @param y Y coordinate in [-1, mapHeight]
+ * @return True if a bomb is at the position
+ */
+bool Simulation::hasBombAt(int x, int y) const {
+    return bombGrid[map->getIndex(x, y)] != BombPool::INVALID_HANDLE;
+}
+
+/**
+ * @brief Add a bomb to the pool and the occupancy index
+ * @param bomb Bomb to add
+ */
+void Simulation::addBomb(const Bomb& bomb) {
+    BombPool::Handle handle = bombs.add(bomb);
+    if (handle != BombPool::INVALID_HANDLE) {
+        bombGrid[map->getIndex(bomb.getX(), bomb.getY())] = handle;
+        flowField.closeCell(map->getIndex(bomb.getX(), bomb.getY()));
+        fuseWheel.schedule(handle, bomb.getDetonationTick());
+        dangerMap.addBomb(*map, bombs, bombGrid, handle);
+    }
+}
+
+/**
+ * @brief Get the walking distance field towards the player
+ * @return Flow field
+ */
+const FlowField& Simulation::getFlowField() const {
+    return flowField;
+}
+
+/**
+ * @brief Get the earliest tick fire reaches each cell
+ * @return Danger map
+ */
+const DangerMap& Simulation::getDangerMap() const {
+    return dangerMap;
+}
+
+/**
+ * @brief Get the events produced by the last step
+ * @return List of events
+ */
+const std::vector<SimulationEvent>& Simulation::getEvents() const {
+    return events;
+}
+
+/**
+ * @brief Get how many events of a type happened since the match started
+ * 
+ * Unlike getEvents(), the counts survive across steps, so a front end
+ * that only samples the simulation now and then can still tell which
+ * events happened in between.
+ * 
+ * @param event Event type
+ * @return Cumulative count
+ */
+std::uint64_t Simulation::getEventCount(SimulationEvent event) const {
+    return eventCounts[static_cast<int>(event)];
+}
+
+/**
+ * @brief Check if the match is lost
+ * @return True if the player has no lives left
+ */
+bool Simulation::isGameOver() const {
+    return gameOver;
+}
+
+/**
+ * @brief Check if the match is won
+ * @return True if all enemies are dead
+ */
+bool Simulation::isVictory() const {
+    return youWin;
+}
+
+/**
+ * @brief Choose how enemies decide
+ * @param ai Enemy AI
+ * @param budget Limits of the search
+ */
+void Simulation::setEnemyAi(EnemyAi ai, const SearchBudget& budget) {
+    enemyAi = ai;
+    searchBudget = budget;
+    if (searchBudget.nodesPerEnemy < 1) {
+        searchBudget.nodesPerEnemy = 1;
+    }
+}
+
+/**
+ * @brief Get how enemies decide
+ * @return Enemy AI
+ */
+EnemyAi Simulation::getEnemyAi() const {
+    return enemyAi;
+}
+
+/**
+ * @brief Get the limits of the SEARCH enemy AI
+ * @return Search budget
+ */
+const SearchBudget& Simulation::getSearchBudget() const {
+    return searchBudget;
+}
+
+/**
+ * @brief Get how many search decisions fell back to the standard AI
+ * @return Fallback count since the match started
+ */
+std::uint64_t Simulation::getSearchFallbacks() const {
+    return searchFallbacks;
+}
+
+/**
+ * @brief Spread the enemy decisions over a number of threads
+ * @param count Threads including the one calling step() (1: no pool)
+ */
+void Simulation::setWorkerThreads(int count) {
+    count = std::max(1, count);
+    delete workers;
+    workers = count > 1 ? new WorkerPool(count) : nullptr;
+    searches.assign(static_cast<size_t>(count), EnemySearch());
+    pathfinders.assign(static_cast<size_t>(count), HierarchicalPathfinder());
+    if (clusterGraph.isBuilt()) {
+        for (HierarchicalPathfinder& pathfinder : pathfinders) {
+            pathfinder.reserve(clusterGraph.getNodeCapacity());
+        }
+    }
+}
+
+/**
+ * @brief Get the number of threads deciding for the enemies
+ * @return Thread count, the one calling step() included
+ */
+int Simulation::getWorkerThreads() const {
+    return static_cast<int>(searches.size());
+}
+
+/**
+ * @brief Create the enemies
+ * @param count Number of enemies
+ */
+void Simulation::spawnEnemies(int count) {
+    // Create enemies at different starting positions
+    const int corners[3][2] = {
+        {mapWidth - 2, mapHeight - 2},
+        {mapWidth - 2, 1},
+        {1, mapHeight - 2}
+    };
+    for (int i = 0; i < count && i < 3; i++) {
+        enemies.push_back(new Enemy(corners[i][0], corners[i][1], enemyMoveDelay, enemyBombDelay));
+    }
+    
+    if (count <= 3) {
+        return;
+    }
+    
+    // Spread the rest evenly over the empty cells away from the player start
+    std::vector<int> freeCells;
+    for (int y = 0; y < mapHeight; y++) {
+        for (int x = 0; x < mapWidth; x++) {
+            bool nearPlayer = std::abs(x - playerStartX) + std::abs(y - playerStartY) <= 3;
+            if (map->getCellUnchecked(x, y) == CellType::EMPTY && !nearPlayer) {
+                freeCells.push_back(y * mapWidth + x);
+            }
+        }
+    }
+    if (freeCells.empty()) {
+        return;
+    }
+    
+    int extra = count - 3;
+    for (int i = 0; i < extra; i++) {
+        int cell = freeCells[static_cast<size_t>(i) * freeCells.size() / extra];
+        enemies.push_back(new Enemy(cell % mapWidth, cell / mapWidth, enemyMoveDelay, enemyBombDelay));
+    }
+}
+
+/**
+ * @brief Record an event of the current step
+ * @param event Event to record
+ */
+void Simulation::emit(SimulationEvent event) {
+    events.push_back(event);
+    eventCounts[static_cast<int>(event)]++;
+}
+
+/**
+ * @brief Place a player bomb at the player's position
+ */
+void Simulation::placePlayerBomb() {
+    if (!player->canPlaceBomb()) {
+        return;
+    }
+    
+    // Check if there's already a bomb at this position
+    if (hasBombAt(player->getX(), player->getY())) {
+        return;
+    }
+    
+    // Use player's bomb range
+    addBomb(Bomb(player->getX(), player->getY(), 
+                 Bomb::OwnerType::PLAYER, 
+                 tick + bombFuse, 
+                 player->getBombRange()));
+    player->placeBomb();
+    
+    emit(SimulationEvent::BOMB_PLACED);
+}
+
+/**
+ * @brief Apply player movement input
+ * @param input Player commands for this tick
+ */
+void Simulation::processInput(const SimulationInput& input) {
+    if (!player->isAlive()) {
+        return;
+    }
+    
+    moveTimer++;
+    
+    if (moveTimer >= moveDelay) {
+        int newX = player->getX();
+        int newY = player->getY();
+        bool moved = false;
+        
+        if (input.moveUp) {
+            newY = player->getY() - 1;
+            moved = true;
+        } else if (input.moveDown) {
+            newY = player->getY() + 1;
+            moved = true;
+        } else if (input.moveLeft) {
+            newX = player->getX() - 1;
+            moved = true;
+        } else if (input.moveRight) {
+            newX = player->getX() + 1;
+            moved = true;
+        }
+        
+        if (moved && map->isWalkable(newX, newY)) {
+            // Check if there's a bomb at the new position
+            if (!hasBombAt(newX, newY)) {
+                if (input.moveUp) {
+                    player->moveUp();
+                } else if (input.moveDown) {
+                    player->moveDown();
+                } else if (input.moveLeft) {
+                    player->moveLeft();
+                } else if (input.moveRight) {
+                    player->moveRight();
+                }
+                moveTimer = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Update enemies, bombs and collisions
+ */
+void Simulation::update() {
+    // Handle player death and respawn
+    if (!player->isAlive()) {
+        handlePlayerDeath();
+    }
+    
+    if (!player->isAlive()) {
+        return;
+    }
+    
+    // Update enemies AI (all enemies move on the same tick)
+    enemyMoveTimer++;
+    bool enemiesMove = enemyMoveTimer >= enemyMoveDelay;
+    
+    // One shared distance field serves every enemy, and the cluster
+    // graph the ones beyond its reach
+    if (enemiesMove) {
+        flowField.setTarget(map->getIndex(player->getX(), player->getY()));
+        flowField.update(*map, bombGrid);
+        clusterGraph.update(*map);
+    }
+    
+    // Decide phase: every enemy chooses from the state at the start of
+    // the tick and writes nothing but itself and its decision slot, so
+    // the enemies can be split over the worker pool. Search enemies share
+    // one time budget per tick.
+    std::uint64_t decisionSeed = aiRandom.next();
+    enemyDecisions.resize(enemies.size());
+    int thinkers = 0;
+    if (enemiesMove && enemyAi == EnemyAi::SEARCH) {
+        thinkStart = std::chrono::steady_clock::now();
+        for (Enemy* enemy : enemies) {
+            thinkers += enemy && enemy->isAlive() && !isRoaming(*enemy) ? 1 : 0;
+        }
+    }
+    thinkersLeft.store(thinkers);
+    
+    if (workers) {
+        workers->run(enemies.size(), DECIDE_CHUNK_SIZE,
+                     [this, enemiesMove, decisionSeed](std::size_t begin, std::size_t end, int worker) {
+                         decideEnemies(begin, end, worker, enemiesMove, decisionSeed);
+                     });
+    } else {
+        decideEnemies(0, enemies.size(), 0, enemiesMove, decisionSeed);
+    }
+    
+    // Apply phase: in enemy order, so the outcome does not depend on who
+    // decided what when. Cells can have been taken since the decide
+    // phase: the first enemy to step into a cell gets it, and no enemy
+    // steps onto a bomb dropped earlier in this phase; an enemy that
+    // loses its cell stays put for this move.
+    if (enemiesMove && ++moveClaimGeneration == 0) {
+        std::fill(moveClaims.begin(), moveClaims.end(), 0);
+        moveClaimGeneration = 1;
+    }
+    
+    for (size_t enemyIndex = 0; enemyIndex < enemies.size(); enemyIndex++) {
+        Enemy* enemy = enemies[enemyIndex];
+        if (enemy && enemy->isAlive()) {
+            const EnemyDecision& decision = enemyDecisions[enemyIndex];
+            if (decision.fellBack) {
+                searchFallbacks++;
+            }
+            
+            // Move enemy first, then place bomb in previous position
+            bool enemyMoved = false;
+            int previousX = enemy->getX();
+            int previousY = enemy->getY();
+            
+            if (decision.direction >= 0) {
+                int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+                int newX = previousX + directions[decision.direction][0];
+                int newY = previousY + directions[decision.direction][1];
+                int target = map->getIndex(newX, newY);
+                
+                if (!hasBombAt(newX, newY) && moveClaims[target] != moveClaimGeneration) {
+                    moveClaims[target] = moveClaimGeneration;
+                    
+                    // Move enemy
+                    if (decision.direction == 0) enemy->moveUp();
+                    else if (decision.direction == 1) enemy->moveDown();
+                    else if (decision.direction == 2) enemy->moveLeft();
+                    else if (decision.direction == 3) enemy->moveRight();
+                    
+                    enemyMoved = true;
+                }
+            }
+            
+            // Place bomb in previous position if enemy wants to and has moved
+            // This ensures enemy is not trapped by its own bomb
+            if (decision.placeBomb && enemy->canPlaceBomb() && enemyMoved) {
+                // Check if there's already a bomb at the previous position
+                if (!hasBombAt(previousX, previousY)) {
+                    // Place bomb at previous position (where enemy was before moving)
+                    addBomb(Bomb(previousX, previousY, Bomb::OwnerType::ENEMY, tick + bombFuse, ENEMY_BOMB_RANGE,
+                                 static_cast<int>(enemyIndex)));
+                    enemy->placeBomb();
+                }
+            }
+        }
+    }
+    
+    if (enemiesMove) {
+        enemyMoveTimer = 0;
+    }
+    
+    // Explode the bombs whose fuse runs out on this tick, together with
+    // every bomb their blasts set off
+    bombsToRemove.clear();
+    fuseWheel.collectDue(tick, bombsToRemove);
+    if (!bombsToRemove.empty()) {
+        // Resolve in map order, not in the order the pool and the wheel
+        // happen to hold the bombs, so a restored match blows up (and
+        // drops power-ups) exactly like the original
+        std::sort(bombsToRemove.begin(), bombsToRemove.end(),
+                  [this](BombPool::Handle a, BombPool::Handle b) {
+                      const Bomb& first = bombs.get(a);
+                      const Bomb& second = bombs.get(b);
+                      return map->getIndex(first.getX(), first.getY()) <
+                             map->getIndex(second.getX(), second.getY());
+                  });
+        handleBombExplosions();
+    }
+    
+    // Check collisions with explosions
+    checkPlayerCollisions();
+    checkEnemyCollisions();
+    
+    // Check power-up collisions
+    checkPowerUpCollisions();
+    
+    // Check victory condition
+    checkVictory();
+    
+    // Put out the explosions whose lifetime ended on this tick
+    map->expireExplosions(tick);
+}
+
+/**
+ * @brief Decide phase for a range of enemies
+ * @param begin First enemy index
+ * @param end Enemy index past the last one
+ * @param worker Worker running the range
+ * @param enemiesMove Whether enemies move on this tick
+ * @param decisionSeed Seed of this tick's enemy decisions
+ */
+void Simulation::decideEnemies(std::size_t begin, std::size_t end, int worker,
+                               bool enemiesMove, std::uint64_t decisionSeed) {
+    for (std::size_t enemyIndex = begin; enemyIndex < end; enemyIndex++) {
+        Enemy* enemy = enemies[enemyIndex];
+        EnemyDecision& decision = enemyDecisions[enemyIndex];
+        decision.direction = -1;
+        decision.placeBomb = false;
+        decision.fellBack = false;
+        if (!enemy || !enemy->isAlive()) {
+            continue;
+        }
+        
+        // Each enemy draws from its own generator, seeded from the AI
+        // stream, so its numbers do not depend on the evaluation order
+        Random random(decisionSeed ^ ((enemyIndex + 1) * 0xD1B54A32D192ED03ull));
+        
+        // Update enemy AI
+        decision.placeBomb = enemy->update(random);
+        if (!enemiesMove) {
+            continue;
+        }
+        
+        // Enemies beyond the flow field's reach have nothing to plan
+        // against yet; they just head for the player
+        if (enemyAi == EnemyAi::SEARCH && !isRoaming(*enemy)) {
+            // Each enemy gets an even share of the time left for the
+            // enemies still waiting, which run side by side on the workers
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+            int waiting = thinkersLeft.fetch_sub(1);
+            if (searchBudget.microseconds > 0) {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                std::chrono::steady_clock::time_point budgetEnd =
+                    thinkStart + std::chrono::microseconds(searchBudget.microseconds);
+                int parallel = std::min(waiting, static_cast<int>(searches.size()));
+                deadline = now + (budgetEnd - now) * parallel / std::max(waiting, 1);
+            }
+            
+            EnemyAction action;
+            if (searchEnemyAction(*enemy, searches[worker], deadline, action)) {
+                decision.direction = action.direction;
+                decision.placeBomb = action.placeBomb;
+                continue;
+            }
+            decision.fellBack = true;
+        }
+        
+        decision.direction = chooseEnemyDirection(*enemy, random, pathfinders[worker]);
+    }
+}
+
+/**
+ * @brief Check whether an enemy is beyond the flow field's reach
+ * @param enemy Enemy to check
+ * @return True on large maps if the field has no distance for the enemy
+ */
+bool Simulation::isRoaming(const Enemy& enemy) const {
+    return clusterGraph.isBuilt() &&
+           flowField.getDistance(map->getIndex(enemy.getX(), enemy.getY())) == FlowField::UNREACHABLE;
+}
+
+/**
+ * @brief Choose an enemy's step with the standard AI
+ * @param enemy Enemy to move
+ * @param random Random generator of the enemy's decision
+ * @param pathfinder Path query scratch space of the calling worker
+ * @return Direction (0=up, 1=down, 2=left, 3=right), or -1 to stay
+ */
+int Simulation::chooseEnemyDirection(const Enemy& enemy, Random& random,
+                                     HierarchicalPathfinder& pathfinder) const {
+    // Step towards the player along the flow field, or wander in a
+    // random free direction when no step gets closer. Cells fire
+    // reaches before the enemy's next move are avoided; an enemy
+    // already standing in one runs to the cell that blows last
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    std::uint64_t nextMoveTick = tick + enemyMoveDelay;
+    int currentIndex = map->getIndex(enemy.getX(), enemy.getY());
+    
+    // Start at a random direction so ties and wandering vary;
+    // every direction is still tried once
+    int firstDir = static_cast<int>(random.nextBelow(4));
+    int chosenDir = -1;
+    int freeDir = -1;
+    int escapeDir = -1;
+    std::uint32_t bestDistance = flowField.getDistance(currentIndex);
+    std::uint64_t latestDetonation = dangerMap.getDetonationTick(currentIndex);
+    
+    // Out of the field's reach, the first step of a long path over the
+    // cluster graph takes its place
+    int roamDir = -1;
+    bool roamDirFree = false;
+    if (isRoaming(enemy)) {
+        pathfinder.findPath(clusterGraph, *map, currentIndex,
+                            map->getIndex(player->getX(), player->getY()), roamDir);
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        int dir = (firstDir + i) & 3;
+        int newX = enemy.getX() + directions[dir][0];
+        int newY = enemy.getY() + directions[dir][1];
+        
+        // Enemies stand on valid cells, so neighbours are inside the map border;
+        // they never step onto bombs or explosions
+        if (!map->isWalkableUnchecked(newX, newY) || hasBombAt(newX, newY) ||
+            map->getCellUnchecked(newX, newY) == CellType::EXPLOSION) {
+            continue;
+        }
+        
+        int newIndex = map->getIndex(newX, newY);
+        if (!dangerMap.isSafeUntil(newIndex, nextMoveTick)) {
+            if (dangerMap.getDetonationTick(newIndex) > latestDetonation) {
+                latestDetonation = dangerMap.getDetonationTick(newIndex);
+                escapeDir = dir;
+            }
+            continue;
+        }
+        
+        if (freeDir < 0) {
+            freeDir = dir;
+        }
+        if (dir == roamDir) {
+            roamDirFree = true;
+        }
+        
+        std::uint32_t distance = flowField.getDistance(newIndex);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            chosenDir = dir;
+        }
+    }
+    
+    if (chosenDir < 0 && roamDirFree) {
+        chosenDir = roamDir;
+    }
+    if (chosenDir < 0) {
+        chosenDir = freeDir;
+    }
+    if (chosenDir < 0 && !dangerMap.isSafeUntil(currentIndex, nextMoveTick)) {
+        chosenDir = escapeDir;
+    }
+    
+    return chosenDir;
+}
+
+/**
+ * @brief Choose an enemy's action with the search AI
+ * @param enemy Enemy to move
+ * @param search Search scratch space of the calling worker
+ * @param deadline Time by which the search has to stop
+ * @param action Output, set only on success
+ * @return False if the budget did not allow a decision
+ */
+bool Simulation::searchEnemyAction(const Enemy& enemy, EnemySearch& search,
+                                   std::chrono::steady_clock::time_point deadline,
+                                   EnemyAction& action) const {
+    SearchProblem problem;
+    problem.map = map;
+    problem.bombGrid = &bombGrid;
+    problem.danger = &dangerMap;
+    problem.flow = &flowField;
+    problem.tick = tick;
+    problem.enemyCell = map->getIndex(enemy.getX(), enemy.getY());
+    problem.playerCell = map->getIndex(player->getX(), player->getY());
+    problem.bombsLeft = enemy.getBombCount();
+    problem.ticksUntilBombReady = enemy.getTicksUntilBombReady();
+    problem.moveDelay = enemyMoveDelay;
+    problem.bombDelay = enemyBombDelay;
+    problem.bombFuse = bombFuse;
+    problem.bombRange = ENEMY_BOMB_RANGE;
+    problem.explosionDuration = explosionDuration;
+    
+    return search.decide(problem, deadline, searchBudget.nodesPerEnemy, action);
+}
+
+/**
+ * @brief Explode the bombs in bombsToRemove and every bomb they set off
+ */
+void Simulation::handleBombExplosions() {
+    blastResolver.resolve(*map, bombs, bombGrid, bombsToRemove, blast);
+    
+    // Create explosion; each cell burns for the same number of ticks
+    for (int index : blast.cells) {
+        map->igniteCell(index, tick + explosionDuration);
+    }
+    
+    // Destroy blocks and spawn power-ups there (30% chance each)
+    for (int index : blast.destroyedBlocks) {
+        map->setCellAt(index, CellType::EMPTY);
+        flowField.openCell(index);
+        clusterGraph.markCellChanged(index);
+        if (lootRandom.chance(30)) {
+            spawnPowerUp(map->getIndexX(index), map->getIndexY(index));
+        }
+    }
+    
+    // Remove exploded bombs
+    for (BombPool::Handle handle : blast.detonated) {
+        Bomb& bomb = bombs.get(handle);
+        bomb.explode();
+        emit(SimulationEvent::BOMB_EXPLODED);
+        
+        // Bombs set off early are still waiting on the wheel
+        fuseWheel.cancel(handle);
+        
+        // Get bomb owner from bomb itself
+        Bomb::OwnerType owner = bomb.getOwner();
+        int ownerIndex = bomb.getOwnerIndex();
+        
+        bombGrid[map->getIndex(bomb.getX(), bomb.getY())] = BombPool::INVALID_HANDLE;
+        flowField.openCell(map->getIndex(bomb.getX(), bomb.getY()));
+        bombs.remove(handle);
+        
+        // Return bomb to the owner
+        if (owner == Bomb::OwnerType::PLAYER) {
+            player->setBombCount(player->getBombCount() + 1);
+        } else if (owner == Bomb::OwnerType::ENEMY) {
+            // Dead enemies get theirs back too, which keeps the count balanced
+            Enemy* enemy = enemies[ownerIndex];
+            enemy->setBombCount(enemy->getBombCount() + 1);
+        }
+    }
+    
+    // Only the chain's footprints and the bombs reaching into them or
+    // past the destroyed blocks need restamping
+    dangerMap.removeChain(*map, bombs, bombGrid, blast.cells, blast.destroyedBlocks);
+}
+
+/**
+ * @brief Check collisions between player and explosions
+ */
+void Simulation::checkPlayerCollisions() {
+    if (!player->isAlive()) {
+        return;
+    }
+    
+    // Check collision with explosions
+    CellType cell = map->getCell(player->getX(), player->getY());
+    if (cell == CellType::EXPLOSION) {
+        player->kill();
+        return;
+    }
+    
+    // Check collision with enemies
+    for (Enemy* enemy : enemies) {
+        if (enemy && enemy->isAlive()) {
+            if (enemy->getX() == player->getX() && enemy->getY() == player->getY()) {
+                // Enemy touched player - kill player
+                player->kill();
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check collisions between enemies and explosions
+ */
+void Simulation::checkEnemyCollisions() {
+    for (Enemy* enemy : enemies) {
+        if (enemy && enemy->isAlive()) {
+            CellType cell = map->getCell(enemy->getX(), enemy->getY());
+            if (cell == CellType::EXPLOSION) {
+                enemy->kill();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check if all enemies are dead (victory condition)
+ */
+void Simulation::checkVictory() {
+    if (youWin || gameOver) {
+        return;
+    }
+    
+    bool allEnemiesDead = true;
+    for (Enemy* enemy : enemies) {
+        if (enemy && enemy->isAlive()) {
+            allEnemiesDead = false;
+            break;
+        }
+    }
+    
+    if (allEnemiesDead && enemies.size() > 0) {
+        youWin = true;
+        emit(SimulationEvent::YOU_WIN);
+    }
+}
+
+/**
+ * @brief Handle player death and respawn
+ */
+void Simulation::handlePlayerDeath() {
+    // Check lives BEFORE respawn (kill() already reduced lives)
+    // We need to check if there are lives remaining AFTER the death
+    int currentLives = player->getLives();
+    
+    if (currentLives > 0) {
+        // Respawn player at starting position
+        player->respawn(playerStartX, playerStartY);
+    } else {
+        // Game over - no lives left
+        gameOver = true;
+        emit(SimulationEvent::GAME_OVER);
+    }
+}
+
+/**
+ * @brief Check collisions between player and power-ups
+ */
+void Simulation::checkPowerUpCollisions() {
+    if (!player->isAlive()) {
+        return;
+    }
+    
+    for (PowerUp* powerUp : powerUps) {
+        if (powerUp && !powerUp->isCollected()) {
+            if (powerUp->getX() == player->getX() && powerUp->getY() == player->getY()) {
+                emit(SimulationEvent::POWERUP_COLLECTED);
+                
+                // Apply power-up effect
+                switch (powerUp->getType()) {
+                    case PowerUpType::EXTRA_BOMB:
+                        player->increaseMaxBombs();
+                        break;
+                    case PowerUpType::EXTRA_LIFE:
+                        player->addLife();
+                        break;
+                    case PowerUpType::INCREASE_RANGE:
+                        player->increaseBombRange();
+                        break;
+                }
+                
+                powerUp->collect();
+            }
+        }
+    }
+    
+    // Remove collected power-ups
+    powerUps.erase(
+        std::remove_if(powerUps.begin(), powerUps.end(),
+            [](PowerUp* pu) {
+                if (pu && pu->isCollected()) {
+                    delete pu;
+                    return true;
+                }
+                return false;
+            }),
+        powerUps.end()
+    );
+}
+
+/**
+ * @brief Spawn a power-up at a position (random chance)
+ * @param x X coordinate
+ * @param y Y coordinate
+ */
+void Simulation::spawnPowerUp(int x, int y) {
+    // Check if there's already a power-up at this position
+    for (PowerUp* powerUp : powerUps) {
+        if (powerUp && powerUp->getX() == x && powerUp->getY() == y) {
+            return; // Don't spawn if already exists
+        }
+    }
+    
+    // Randomly choose power-up type
+    PowerUpType type;
+    switch (lootRandom.nextBelow(3)) {
+        case 0:
+            type = PowerUpType::EXTRA_BOMB;
+            break;
+        case 1:
+            type = PowerUpType::EXTRA_LIFE;
+            break;
+        case 2:
+            type = PowerUpType::INCREASE_RANGE;
+            break;
+        default:
+            type = PowerUpType::EXTRA_BOMB;
+    }
+    
+    PowerUp* newPowerUp = new PowerUp(x, y, type);
+    powerUps.push_back(newPowerUp);
+}
+
+/**
+ * @brief Pack the match into a GameState
+ * @param state Output state
+ * @return False if the match exceeds the GameState capacities
+ */
+bool Simulation::saveState(GameState& state) const {
+    if (mapWidth > GameState::MAX_MAP_WIDTH || mapHeight > GameState::MAX_MAP_HEIGHT ||
+        enemies.size() > GameState::MAX_ENEMIES || bombs.size() > GameState::MAX_BOMBS ||
+        powerUps.size() > GameState::MAX_POWERUPS || bombFuse > 0xFFFF || explosionDuration > 0xFFFF) {
+        return false;
+    }
+    
+    state.tick = tick;
+    for (int i = 0; i < SIMULATION_EVENT_TYPES; i++) {
+        state.eventCounts[i] = eventCounts[i];
+    }
+    state.aiRandom = aiRandom;
+    state.lootRandom = lootRandom;
+    state.moveTimer = moveTimer;
+    state.enemyMoveTimer = enemyMoveTimer;
+    state.gameOver = gameOver;
+    state.victory = youWin;
+    state.mapWidth = static_cast<std::uint8_t>(mapWidth);
+    state.mapHeight = static_cast<std::uint8_t>(mapHeight);
+    
+    player->saveState(state.player);
+    
+    state.enemyCount = static_cast<std::uint8_t>(enemies.size());
+    for (size_t i = 0; i < enemies.size(); i++) {
+        enemies[i]->saveState(state.enemies[i]);
+    }
+    
+    state.bombCount = 0;
+    for (const Bomb& bomb : bombs) {
+        BombState& saved = state.bombs[state.bombCount++];
+        saved.x = static_cast<std::uint8_t>(bomb.getX());
+        saved.y = static_cast<std::uint8_t>(bomb.getY());
+        saved.owner = static_cast<std::int8_t>(
+            bomb.getOwner() == Bomb::OwnerType::PLAYER ? -1 : bomb.getOwnerIndex());
+        saved.range = static_cast<std::uint8_t>(std::min(bomb.getExplosionRange(), 255));
+        saved.fuse = static_cast<std::uint16_t>(bomb.getRemainingTicks(tick));
+    }
+    
+    state.powerUpCount = 0;
+    for (const PowerUp* powerUp : powerUps) {
+        PowerUpState& saved = state.powerUps[state.powerUpCount++];
+        saved.x = static_cast<std::uint8_t>(powerUp->getX());
+        saved.y = static_cast<std::uint8_t>(powerUp->getY());
+        saved.type = powerUp->getType();
+    }
+    
+    // Burning cells, soonest to go out first (the order igniteCell needs)
+    bool fits = true;
+    state.explosionCount = 0;
+    map->getExplosionBits().forEachSetBit([&](std::size_t index) {
+        if (state.explosionCount == GameState::MAX_EXPLOSIONS) {
+            fits = false;
+            return;
+        }
+        std::uint64_t expiry = map->getExplosionExpiry(static_cast<int>(index));
+        state.explosions[state.explosionCount++] = {
+            static_cast<std::uint16_t>(index),
+            static_cast<std::uint16_t>(expiry > tick ? expiry - tick : 0)
+        };
+    });
+    std::sort(state.explosions, state.explosions + state.explosionCount,
+              [](const ExplosionState& a, const ExplosionState& b) {
+                  return a.remaining != b.remaining ? a.remaining < b.remaining : a.index < b.index;
+              });
+    
+    const Bitboard& blockBits = map->getBlockBits();
+    std::fill(state.blockWords, state.blockWords + GameState::BLOCK_WORDS, 0);
+    std::copy(blockBits.data(), blockBits.data() + blockBits.wordCount(), state.blockWords);
+    
+    return fits;
+}
+
+/**
+ * @brief Continue the match from a GameState
+ * @param state Saved state
+ * @return False if the state does not fit this match (nothing is changed)
+ */
+bool Simulation::restoreState(const GameState& state) {
+    if (state.mapWidth != mapWidth || state.mapHeight != mapHeight ||
+        state.enemyCount != enemies.size()) {
+        return false;
+    }
+    
+    tick = state.tick;
+    for (int i = 0; i < SIMULATION_EVENT_TYPES; i++) {
+        eventCounts[i] = state.eventCounts[i];
+    }
+    aiRandom = state.aiRandom;
+    lootRandom = state.lootRandom;
+    moveTimer = state.moveTimer;
+    enemyMoveTimer = state.enemyMoveTimer;
+    gameOver = state.gameOver;
+    youWin = state.victory;
+    events.clear();
+    
+    player->restoreState(state.player);
+    for (size_t i = 0; i < enemies.size(); i++) {
+        enemies[i]->restoreState(state.enemies[i]);
+    }
+    
+    // Swap the bombs
+    while (!bombs.empty()) {
+        BombPool::Handle handle = bombs.handleAt(bombs.size() - 1);
+        const Bomb& bomb = bombs.get(handle);
+        bombGrid[map->getIndex(bomb.getX(), bomb.getY())] = BombPool::INVALID_HANDLE;
+        fuseWheel.cancel(handle);
+        bombs.remove(handle);
+    }
+    for (int i = 0; i < state.bombCount; i++) {
+        const BombState& saved = state.bombs[i];
+        addBomb(Bomb(saved.x, saved.y,
+                     saved.owner < 0 ? Bomb::OwnerType::PLAYER : Bomb::OwnerType::ENEMY,
+                     tick + saved.fuse, saved.range, saved.owner < 0 ? 0 : saved.owner));
+    }
+    
+    // Swap the power-ups
+    for (PowerUp* powerUp : powerUps) {
+        delete powerUp;
+    }
+    powerUps.clear();
+    for (int i = 0; i < state.powerUpCount; i++) {
+        const PowerUpState& saved = state.powerUps[i];
+        powerUps.push_back(new PowerUp(saved.x, saved.y, saved.type));
+    }
+    
+    // Terrain, then the fires on top of it
+    map->restoreBlocks(state.blockWords);
+    for (int i = 0; i < state.explosionCount; i++) {
+        map->igniteCell(state.explosions[i].index, tick + state.explosions[i].remaining);
+    }
+    flowField.invalidate();
+    dangerMap.rebuild(*map, bombs, bombGrid);
+    if (clusterGraph.isBuilt()) {
+        clusterGraph.build(*map, CLUSTER_SIZE);
+    }
+    
+    return true;
+}
@@ -0,0 +1,246 @@
+#include "../include/SoakRunner.hpp"
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * @brief Constructor for SoakRunner
+ * @param seed Seed of the random input stream
+ * @param mapWidth Map width in cells
+ * @param mapHeight Map height in cells
+ * @param enemyCount Number of enemies per match
+ */
+SoakRunner::SoakRunner(std::uint32_t seed, int mapWidth, int mapHeight, int enemyCount)
+    : mapWidth(mapWidth), mapHeight(mapHeight), enemyCount(enemyCount),
+      simulation(nullptr), random(seed), matchSeed(0), holdTicks(0) {
+}
+
+/**
+ * @brief Destructor
+ */
+SoakRunner::~SoakRunner() {
+    delete simulation;
+}
+
+/**
+ * @brief Simulate a number of ticks, checking invariants after each
+ * @param ticks Ticks to simulate
+ * @param log Stream for progress lines and violations
+ * @return Summary of the run
+ */
+SoakReport SoakRunner::run(std::uint64_t ticks, std::ostream& log) {
+    using Clock = std::chrono::steady_clock;
+    
+    report = SoakReport();
+    restart();
+    
+    Clock::time_point runStart = Clock::now();
+    Clock::duration stepTime = Clock::duration::zero();
+    
+    for (std::uint64_t i = 0; i < ticks; i++) {
+        if (simulation->isGameOver() || simulation->isVictory()) {
+            restart();
+        }
+        
+        SimulationInput input = nextInput();
+        
+        Clock::time_point stepStart = Clock::now();
+        simulation->step(input);
+        stepTime += Clock::now() - stepStart;
+        
+        report.ticks++;
+        checkInvariants(log);
+        
+        if (report.ticks % PROGRESS_INTERVAL == 0) {
+            log << "  " << report.ticks << " ticks, " << report.matches << " matches, "
+                << report.violations << " violations" << std::endl;
+        }
+    }
+    
+    report.stepSeconds = std::chrono::duration<double>(stepTime).count();
+    report.totalSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    return report;
+}
+
+/**
+ * @brief Start a new match
+ */
+void SoakRunner::restart() {
+    delete simulation;
+    
+    // Each match gets its own seed from the input stream, so a whole run
+    // is reproducible from the runner's seed
+    matchSeed = static_cast<std::uint32_t>(random.next());
+    simulation = new Simulation(mapWidth, mapHeight, 60, enemyCount, matchSeed);
+    
+    // Every other match uses the search AI, limited by nodes only so the
+    // run stays reproducible
+    if (report.matches % 2 == 1) {
+        SearchBudget budget;
+        budget.microseconds = 0;
+        simulation->setEnemyAi(EnemyAi::SEARCH, budget);
+    }
+    report.matches++;
+    holdTicks = 0;
+}
+
+/**
+ * @brief Generate the input of the next tick
+ * @return Random player commands
+ */
+SimulationInput SoakRunner::nextInput() {
+    // Hold a direction (or nothing) for a while, like a player would,
+    // so the player actually travels instead of jittering in place
+    if (holdTicks <= 0) {
+        held = SimulationInput();
+        switch (random.nextBelow(5)) {
+            case 0: held.moveUp = true; break;
+            case 1: held.moveDown = true; break;
+            case 2: held.moveLeft = true; break;
+            case 3: held.moveRight = true; break;
+            default: break;
+        }
+        holdTicks = 1 + static_cast<int>(random.nextBelow(40));
+    }
+    holdTicks--;
+    
+    SimulationInput input = held;
+    input.placeBomb = random.nextBelow(30) == 0;
+    return input;
+}
+
+/**
+ * @brief Check every invariant on the current state
+ * @param log Stream for violations
+ */
+void SoakRunner::checkInvariants(std::ostream& log) {
+    const Player& player = simulation->getPlayer();
+    const std::vector<Enemy*>& enemies = simulation->getEnemies();
+    
+    // Count the bombs each owner has on the map
+    bombsOut.assign(enemies.size() + 1, 0);
+    for (const Bomb& bomb : simulation->getBombs()) {
+        if (bomb.getOwner() == Bomb::OwnerType::PLAYER) {
+            bombsOut[0]++;
+        } else if (bomb.getOwnerIndex() >= 0 &&
+                   bomb.getOwnerIndex() < static_cast<int>(enemies.size())) {
+            bombsOut[bomb.getOwnerIndex() + 1]++;
+        } else {
+            fail(log, "enemy bomb has no valid owner");
+        }
+        
+        if (!isOpenCell(bomb.getX(), bomb.getY())) {
+            fail(log, "bomb inside a wall or block");
+        }
+        if (simulation->getBombAt(bomb.getX(), bomb.getY()) != &bomb) {
+            fail(log, "bomb grid does not point at the bomb");
+        }
+        // A lost match freezes on the tick it ended, bombs included
+        if (!simulation->isGameOver() && bomb.getDetonationTick() <= simulation->getTick()) {
+            fail(log, "bomb outlived its fuse");
+        }
+    }
+    
+    // Bombs in hand plus bombs on the map must add up to the maximum:
+    // more means a bomb was handed out twice, less means one was lost
+    if (player.getBombCount() > player.getMaxBombs()) {
+        fail(log, "player holds more bombs than its maximum");
+    }
+    if (player.getBombCount() + bombsOut[0] != player.getMaxBombs()) {
+        fail(log, "player bombs were not returned to the player");
+    }
+    if (player.isAlive() && !isOpenCell(player.getX(), player.getY())) {
+        fail(log, "player inside a wall or block");
+    }
+    
+    for (size_t i = 0; i < enemies.size(); i++) {
+        const Enemy* enemy = enemies[i];
+        if (enemy->getBombCount() > enemy->getMaxBombs()) {
+            fail(log, "enemy holds more bombs than its maximum");
+        }
+        if (enemy->getBombCount() + bombsOut[i + 1] != enemy->getMaxBombs()) {
+            fail(log, "enemy bombs were not returned to their owner");
+        }
+        if (enemy->isAlive() && !isOpenCell(enemy->getX(), enemy->getY())) {
+            fail(log, "enemy inside a wall or block");
+        }
+    }
+    
+    // The simulation only restamps what a placement or explosion touched;
+    // stamping every bomb from scratch must give the same ticks
+    const Map& map = simulation->getMap();
+    const BombPool& bombs = simulation->getBombs();
+    bombGrid.assign(static_cast<size_t>(map.getStride()) * (map.getHeight() + 2), BombPool::INVALID_HANDLE);
+    for (size_t i = 0; i < bombs.size(); i++) {
+        BombPool::Handle handle = bombs.handleAt(i);
+        const Bomb& bomb = bombs.get(handle);
+        bombGrid[map.getIndex(bomb.getX(), bomb.getY())] = handle;
+    }
+    expectedDanger.reset(bombGrid.size(), map.getStride());
+    expectedDanger.rebuild(map, bombs, bombGrid);
+    
+    const DangerMap& danger = simulation->getDangerMap();
+    for (size_t i = 0; i < bombGrid.size(); i++) {
+        if (danger.getDetonationTick(static_cast<int>(i)) != expectedDanger.getDetonationTick(static_cast<int>(i))) {
+            fail(log, "danger map differs from a full restamp");
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Check that a cell can hold an entity
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return True if the cell is inside the map and not a wall or block
+ */
+bool SoakRunner::isOpenCell(int x, int y) const {
+    const Map& map = simulation->getMap();
+    if (!map.isValidPosition(x, y)) {
+        return false;
+    }
+    
+    CellType cell = map.getCellUnchecked(x, y);
+    return cell != CellType::WALL && cell != CellType::BLOCK;
+}
+
+/**
+ * @brief Record an invariant violation
+ * @param log Stream for violations
+ * @param message Description of what went wrong
+ */
+void SoakRunner::fail(std::ostream& log, const char* message) {
+    report.violations++;
+    if (report.violations <= MAX_LOGGED_VIOLATIONS) {
+        log << "  VIOLATION at tick " << simulation->getTick() << " of match " << report.matches
+            << " (seed " << matchSeed << "): " << message << std::endl;
+    } else if (report.violations == MAX_LOGGED_VIOLATIONS + 1) {
+        log << "  (further violations are counted but not printed)" << std::endl;
+    }
+}
+
+/**
+ * @brief Run the soak test from command line arguments and print a summary
+ * @param argc Number of arguments
+ * @param argv Arguments: [ticks] [seed]
+ * @param out Stream for progress, violations and the summary
+ * @return Exit code (0 if no invariant was violated)
+ */
+int runSoakTest(int argc, char* argv[], std::ostream& out) {
+    std::uint64_t ticks = argc > 0 ? std::strtoull(argv[0], nullptr, 10) : 1000000;
+    std::uint32_t seed = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1;
+    
+    out << "=== Bomberman soak test ===" << std::endl;
+    out << "Ticks: " << ticks << ", seed: " << seed << std::endl;
+    
+    SoakRunner runner(seed);
+    SoakReport report = runner.run(ticks, out);
+    
+    double stepRate = report.stepSeconds > 0.0 ? report.ticks / report.stepSeconds : 0.0;
+    double totalRate = report.totalSeconds > 0.0 ? report.ticks / report.totalSeconds : 0.0;
+    out << "Ticks:       " << report.ticks << " in " << report.matches << " matches" << std::endl;
+    out << "Simulation:  " << static_cast<std::uint64_t>(stepRate) << " ticks/s" << std::endl;
+    out << "With checks: " << static_cast<std::uint64_t>(totalRate) << " ticks/s" << std::endl;
+    out << "Violations:  " << report.violations << std::endl;
+    
+    return report.violations == 0 ? 0 : 1;
+}
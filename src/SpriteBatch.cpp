@@ -0,0 +1,86 @@
+#include "../include/SpriteBatch.hpp"
+
+/**
+ * @brief Constructor for SpriteBatch
+ */
+SpriteBatch::SpriteBatch()
+    : vertices(sf::PrimitiveType::Triangles) {
+}
+
+/**
+ * @brief Generate the atlas texture
+ * @return True if the texture was created
+ */
+bool SpriteBatch::initialize() {
+    sf::Image image(sf::Vector2u(REGION_SIZE * 2, REGION_SIZE), sf::Color::Transparent);
+    
+    // Region 0: white disc, region 1: white square
+    float radius = REGION_SIZE / 2.0f;
+    for (unsigned int y = 0; y < REGION_SIZE; y++) {
+        for (unsigned int x = 0; x < REGION_SIZE; x++) {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            if (dx * dx + dy * dy <= radius * radius) {
+                image.setPixel(sf::Vector2u(x, y), sf::Color::White);
+            }
+            image.setPixel(sf::Vector2u(REGION_SIZE + x, y), sf::Color::White);
+        }
+    }
+    
+    if (!atlas.loadFromImage(image)) {
+        return false;
+    }
+    atlas.setSmooth(true);
+    
+    return true;
+}
+
+/**
+ * @brief Remove every sprite from the batch
+ */
+void SpriteBatch::clear() {
+    vertices.clear();
+}
+
+/**
+ * @brief Add a sprite to the batch
+ * @param shape Atlas region to draw
+ * @param position Screen position of the top-left corner
+ * @param size Size of the sprite in pixels
+ * @param color Tint color
+ */
+void SpriteBatch::add(SpriteShape shape, sf::Vector2f position, sf::Vector2f size, sf::Color color) {
+    // Sample one texel inside the region so smoothing does not bleed
+    // into the neighbouring shape
+    float left = static_cast<float>(shape) * REGION_SIZE + 1.f;
+    float right = left + REGION_SIZE - 2.f;
+    float top = 1.f;
+    float bottom = REGION_SIZE - 1.f;
+    
+    sf::Vertex corners[4];
+    corners[0] = {position, color, sf::Vector2f(left, top)};
+    corners[1] = {position + sf::Vector2f(size.x, 0.f), color, sf::Vector2f(right, top)};
+    corners[2] = {position + sf::Vector2f(0.f, size.y), color, sf::Vector2f(left, bottom)};
+    corners[3] = {position + size, color, sf::Vector2f(right, bottom)};
+    
+    vertices.append(corners[0]);
+    vertices.append(corners[1]);
+    vertices.append(corners[2]);
+    vertices.append(corners[2]);
+    vertices.append(corners[1]);
+    vertices.append(corners[3]);
+}
+
+/**
+ * @brief Draw every sprite of the batch in a single call
+ * @param target Render target
+ * @param states Render states
+ */
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (vertices.getVertexCount() == 0) {
+        return;
+    }
+    
+    states.texture = &atlas;
+    target.draw(vertices, states);
+}
@@ -0,0 +1,86 @@
+#include "../include/TickScheduler.hpp"
+#include <cmath>
+
+/**
+ * @brief Constructor for TickScheduler
+ * @param tickRate Simulation ticks per second
+ * @param maxTicksPerAdvance Upper bound of ticks returned by one advance() call
+ */
+TickScheduler::TickScheduler(int tickRate, int maxTicksPerAdvance)
+    : tickRate(tickRate > 0 ? tickRate : 60),
+      maxTicksPerAdvance(maxTicksPerAdvance > 0 ? maxTicksPerAdvance : 1),
+      tickMicroseconds(1000000 / this->tickRate), accumulator(0) {
+}
+
+/**
+ * @brief Destructor
+ */
+TickScheduler::~TickScheduler() {
+}
+
+/**
+ * @brief Get the tick rate
+ * @return Simulation ticks per second
+ */
+int TickScheduler::getTickRate() const {
+    return tickRate;
+}
+
+/**
+ * @brief Get the duration of a single tick
+ * @return Tick duration in microseconds
+ */
+std::int64_t TickScheduler::getTickMicroseconds() const {
+    return tickMicroseconds;
+}
+
+/**
+ * @brief Get the real time left before the next tick becomes due
+ * @return Time in microseconds
+ */
+std::int64_t TickScheduler::getMicrosecondsUntilNextTick() const {
+    return tickMicroseconds - accumulator;
+}
+
+/**
+ * @brief Accumulate elapsed real time
+ * @param elapsedMicroseconds Real time elapsed since the last call
+ * @return Number of ticks that should be simulated now
+ */
+int TickScheduler::advance(std::int64_t elapsedMicroseconds) {
+    if (elapsedMicroseconds > 0) {
+        accumulator += elapsedMicroseconds;
+    }
+    
+    int ticks = 0;
+    while (accumulator >= tickMicroseconds && ticks < maxTicksPerAdvance) {
+        accumulator -= tickMicroseconds;
+        ticks++;
+    }
+    
+    // After a long stall (window drag, breakpoint) drop the backlog instead
+    // of running a burst of catch-up ticks on every following frame
+    if (accumulator >= tickMicroseconds) {
+        accumulator = 0;
+    }
+    
+    return ticks;
+}
+
+/**
+ * @brief Drop any accumulated time
+ */
+void TickScheduler::reset() {
+    accumulator = 0;
+}
+
+/**
+ * @brief Convert a duration in seconds to ticks
+ * @param seconds Duration in seconds
+ * @param tickRate Simulation ticks per second
+ * @return Duration in ticks (at least one tick)
+ */
+int TickScheduler::secondsToTicks(float seconds, int tickRate) {
+    int ticks = static_cast<int>(std::lround(seconds * tickRate));
+    return ticks > 0 ? ticks : 1;
+}
@@ -0,0 +1,108 @@
+#include "../include/TileMapRenderer.hpp"
+
+/**
+ * @brief Constructor for TileMapRenderer
+ */
+TileMapRenderer::TileMapRenderer()
+    : vertices(sf::PrimitiveType::Triangles), sequence(0) {
+}
+
+/**
+ * @brief Build the vertex array for every cell of a snapshot
+ * @param snapshot Snapshot to draw
+ * @param cellSize Size of each cell in pixels
+ * @param origin Screen position of the top-left cell
+ */
+void TileMapRenderer::build(const GameSnapshot& snapshot, int cellSize, sf::Vector2f origin) {
+    int width = snapshot.mapWidth;
+    int height = snapshot.mapHeight;
+    cells = snapshot.cells;
+    sequence = snapshot.sequence;
+    vertices.resize(cells.size() * 6);
+    
+    // Leave a one pixel gap between cells, as the grid always had
+    float size = static_cast<float>(cellSize - 1);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int cell = y * width + x;
+            sf::Vertex* quad = &vertices[cell * 6];
+            sf::Vector2f topLeft(origin.x + x * cellSize, origin.y + y * cellSize);
+            
+            quad[0].position = topLeft;
+            quad[1].position = topLeft + sf::Vector2f(size, 0.f);
+            quad[2].position = topLeft + sf::Vector2f(0.f, size);
+            quad[3].position = topLeft + sf::Vector2f(0.f, size);
+            quad[4].position = topLeft + sf::Vector2f(size, 0.f);
+            quad[5].position = topLeft + sf::Vector2f(size, size);
+            
+            setCellColor(cell, cells[cell]);
+        }
+    }
+}
+
+/**
+ * @brief Recolor the cells that differ from the last drawn snapshot
+ * @param snapshot Newer snapshot of the map passed to build()
+ */
+void TileMapRenderer::update(const GameSnapshot& snapshot) {
+    if (snapshot.sequence == sequence + 1) {
+        for (int cell : snapshot.changedCells) {
+            if (cells[cell] != snapshot.cells[cell]) {
+                cells[cell] = snapshot.cells[cell];
+                setCellColor(cell, cells[cell]);
+            }
+        }
+    } else if (snapshot.sequence != sequence) {
+        // Snapshots were skipped; compare every cell
+        for (size_t cell = 0; cell < cells.size(); cell++) {
+            if (cells[cell] != snapshot.cells[cell]) {
+                cells[cell] = snapshot.cells[cell];
+                setCellColor(static_cast<int>(cell), cells[cell]);
+            }
+        }
+    }
+    sequence = snapshot.sequence;
+}
+
+/**
+ * @brief Draw the map in a single call
+ * @param target Render target
+ * @param states Render states
+ */
+void TileMapRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    target.draw(vertices, states);
+}
+
+/**
+ * @brief Write the color of one cell into its quad
+ * @param cell Cell index (row-major, without border)
+ * @param type Cell type
+ */
+void TileMapRenderer::setCellColor(int cell, CellType type) {
+    sf::Color color = getCellColor(type);
+    sf::Vertex* quad = &vertices[cell * 6];
+    
+    for (int i = 0; i < 6; i++) {
+        quad[i].color = color;
+    }
+}
+
+/**
+ * @brief Get the fill color of a cell type
+ * @param type Cell type
+ * @return Colour of the cell
+ */
+sf::Color TileMapRenderer::getCellColor(CellType type) {
+    switch (type) {
+        case CellType::EMPTY:
+            return sf::Color(50, 50, 50);
+        case CellType::WALL:
+            return sf::Color(100, 50, 0);
+        case CellType::BLOCK:
+            return sf::Color(150, 75, 0);
+        case CellType::EXPLOSION:
+            return sf::Color::Red;
+    }
+    return sf::Color(50, 50, 50);
+}
@@ -0,0 +1,146 @@
+#include "../include/TimerWheel.hpp"
+
+/**
+ * @brief Constructor for TimerWheel
+ * @param slotCount Number of slots (rounded up to a power of two)
+ * @param capacity Number of distinct handles, [0, capacity)
+ */
+TimerWheel::TimerWheel(std::size_t slotCount, std::size_t capacity)
+    : mask(0), pending(0) {
+    reset(slotCount, capacity);
+}
+
+/**
+ * @brief Destructor
+ */
+TimerWheel::~TimerWheel() {
+}
+
+/**
+ * @brief Drop all timers and resize the wheel
+ * @param slotCount Number of slots (rounded up to a power of two)
+ * @param capacity Number of distinct handles, [0, capacity)
+ */
+void TimerWheel::reset(std::size_t slotCount, std::size_t capacity) {
+    std::size_t slots = 1;
+    while (slots < slotCount) {
+        slots <<= 1;
+    }
+    
+    mask = slots - 1;
+    pending = 0;
+    heads.assign(slots, NONE);
+    tails.assign(slots, NONE);
+    next.assign(capacity, NONE);
+    prev.assign(capacity, NONE);
+    deadlines.assign(capacity, 0);
+    scheduled.assign(capacity, false);
+}
+
+/**
+ * @brief Schedule a handle to fire on a tick
+ * @param handle Handle that is not currently scheduled
+ * @param tick Tick on which the handle becomes due
+ */
+void TimerWheel::schedule(Handle handle, std::uint64_t tick) {
+    if (scheduled[handle]) {
+        unlink(handle);
+    }
+    
+    // Append to the slot so handles due together fire in scheduling order
+    std::size_t slot = static_cast<std::size_t>(tick) & mask;
+    deadlines[handle] = tick;
+    next[handle] = NONE;
+    prev[handle] = tails[slot];
+    if (tails[slot] != NONE) {
+        next[tails[slot]] = handle;
+    } else {
+        heads[slot] = handle;
+    }
+    tails[slot] = handle;
+    scheduled[handle] = true;
+    pending++;
+}
+
+/**
+ * @brief Remove a scheduled handle before it fires
+ * @param handle Handle to cancel (ignored if not scheduled)
+ */
+void TimerWheel::cancel(Handle handle) {
+    if (handle < scheduled.size() && scheduled[handle]) {
+        unlink(handle);
+    }
+}
+
+/**
+ * @brief Check if a handle is scheduled
+ * @param handle Handle to check
+ * @return True if the handle is pending
+ */
+bool TimerWheel::isScheduled(Handle handle) const {
+    return handle < scheduled.size() && scheduled[handle];
+}
+
+/**
+ * @brief Get the tick a handle is scheduled for
+ * @param handle Scheduled handle
+ * @return Due tick
+ */
+std::uint64_t TimerWheel::getDeadline(Handle handle) const {
+    return deadlines[handle];
+}
+
+/**
+ * @brief Unschedule and collect every handle due on or before a tick
+ * @param tick Current tick
+ * @param due Output list; due handles are appended in scheduling order
+ */
+void TimerWheel::collectDue(std::uint64_t tick, std::vector<Handle>& due) {
+    std::size_t slot = static_cast<std::size_t>(tick) & mask;
+    
+    Handle handle = heads[slot];
+    while (handle != NONE) {
+        Handle following = next[handle];
+        
+        // Timers more than one revolution away share the slot; leave them
+        if (deadlines[handle] <= tick) {
+            unlink(handle);
+            due.push_back(handle);
+        }
+        
+        handle = following;
+    }
+}
+
+/**
+ * @brief Get the number of pending timers
+ * @return Pending timer count
+ */
+std::size_t TimerWheel::size() const {
+    return pending;
+}
+
+/**
+ * @brief Unlink a handle from its slot list
+ * @param handle Scheduled handle
+ */
+void TimerWheel::unlink(Handle handle) {
+    std::size_t slot = static_cast<std::size_t>(deadlines[handle]) & mask;
+    
+    if (prev[handle] != NONE) {
+        next[prev[handle]] = next[handle];
+    } else {
+        heads[slot] = next[handle];
+    }
+    
+    if (next[handle] != NONE) {
+        prev[next[handle]] = prev[handle];
+    } else {
+        tails[slot] = prev[handle];
+    }
+    
+    next[handle] = NONE;
+    prev[handle] = NONE;
+    scheduled[handle] = false;
+    pending--;
+}
@@ -0,0 +1,113 @@
+#include "../include/WorkerPool.hpp"
+
+/**
+ * @brief Constructor for WorkerPool
+ * @param workerCount Workers including the calling thread (at least 1)
+ */
+WorkerPool::WorkerPool(int workerCount)
+    : task(nullptr), count(0), chunkSize(1), next(0), busy(0), generation(0), stopping(false) {
+    for (int worker = 1; worker < workerCount; worker++) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, worker);
+    }
+}
+
+/**
+ * @brief Destructor (stops and joins the threads)
+ */
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Get the number of workers, the calling thread included
+ * @return Worker count
+ */
+int WorkerPool::getWorkerCount() const {
+    return static_cast<int>(threads.size()) + 1;
+}
+
+/**
+ * @brief Run a task over [0, count) and wait for it to finish
+ * @param count Number of indices
+ * @param chunkSize Indices per chunk (at least 1)
+ * @param task Loop body
+ */
+void WorkerPool::run(std::size_t count, std::size_t chunkSize, const Task& task) {
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+    
+    // A single chunk is not worth waking anyone for
+    if (threads.empty() || count <= chunkSize) {
+        if (count > 0) {
+            task(0, count, 0);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        this->count = count;
+        this->chunkSize = chunkSize;
+        next.store(0);
+        busy = static_cast<int>(threads.size());
+        generation++;
+    }
+    wake.notify_all();
+    
+    drain(0);
+    
+    // The task lives on the caller's stack, so wait for every thread to
+    // let go of it
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busy == 0; });
+    this->task = nullptr;
+}
+
+/**
+ * @brief Body of a pool thread
+ * @param worker Worker number
+ */
+void WorkerPool::workerLoop(int worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        
+        drain(worker);
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Take chunks of the current run until none are left
+ * @param worker Worker number
+ */
+void WorkerPool::drain(int worker) {
+    for (;;) {
+        std::size_t begin = next.fetch_add(chunkSize);
+        if (begin >= count) {
+            return;
+        }
+        std::size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        (*task)(begin, end, worker);
+    }
+}
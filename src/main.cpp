@@ -1,11 +1,114 @@
 #include "../include/Game.hpp"
+#include "../include/InputReplay.hpp"
+#include "../include/SoakRunner.hpp"
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+/**
+ * @brief Play a replay headless as fast as possible
+ * @param path Replay file
+ * @param threads Threads deciding for the enemies
+ * @return Exit code (0 if the replay could be played)
+ */
+int runReplayHeadless(const std::string& path, int threads) {
+    InputReplay replay;
+    if (!replay.load(path)) {
+        std::cerr << "Failed to load replay " << path << std::endl;
+        return 1;
+    }
+    
+    const ReplayHeader& header = replay.getHeader();
+    std::cout << "=== Bomberman replay ===" << std::endl;
+    std::cout << path << ": " << replay.getTickCount() << " ticks in "
+              << replay.getByteCount() << " bytes, seed " << header.seed << std::endl;
+    
+    Simulation simulation(header.mapWidth, header.mapHeight, header.tickRate,
+                          header.enemyCount, header.seed);
+    // Only the node limit is reproducible; files may still carry a time limit
+    SearchBudget budget = header.searchBudget;
+    budget.microseconds = 0;
+    simulation.setEnemyAi(header.enemyAi, budget);
+    simulation.setWorkerThreads(threads);
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SimulationInput input;
+    while (replay.next(input)) {
+        simulation.step(input);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    int enemiesAlive = 0;
+    for (const Enemy* enemy : simulation.getEnemies()) {
+        enemiesAlive += enemy->isAlive() ? 1 : 0;
+    }
+    
+    std::cout << "Final tick:  " << simulation.getTick() << std::endl;
+    std::cout << "Result:      " << (simulation.isVictory() ? "victory" :
+                                     simulation.isGameOver() ? "game over" : "in progress")
+              << ", " << simulation.getPlayer().getLives() << " lives, "
+              << enemiesAlive << " enemies left" << std::endl;
+    std::cout << "Playback:    " << static_cast<std::uint64_t>(seconds > 0.0 ? replay.getTickCount() / seconds : 0.0)
+              << " ticks/s" << std::endl;
+    return 0;
+}
+
 /**
  * @brief Main entry point of the Bomberman game
+ * 
+ * Options:
+ *   --soak [ticks] [seed]     Run the soak test instead of the game
+ *   --seed <n>                Seed of the match
+ *   --hard [microseconds]     Enemies plan with the search AI, thinking at
+ *                             most the given time per tick (2000 by default;
+ *                             recorded and replayed matches only limit nodes)
+ *   --threads <n>             Threads deciding for the enemies (1 by default)
+ *   --record <file>           Record the input of the match to a replay file
+ *   --replay <file>           Play a replay in the window at normal speed
+ *   --replay <file> --headless  Play a replay without a window, as fast as possible
+ * 
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
  * @return Exit code (0 for success)
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--soak") == 0) {
+        return runSoakTest(argc - 2, argv + 2, std::cout);
+    }
+    
+    const char* seed = nullptr;
+    const char* hard = nullptr;
+    const char* threads = nullptr;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = argv[++i];
+        } else if (std::strcmp(argv[i], "--hard") == 0) {
+            hard = hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])) ? argv[++i] : "";
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    
+    int threadCount = threads ? static_cast<int>(std::strtol(threads, nullptr, 10)) : 1;
+    if (replayPath && headless) {
+        return runReplayHeadless(replayPath, threadCount);
+    }
+    
     std::cout << "=== Bomberman Game ===" << std::endl;
     std::cout << "Controls:" << std::endl;
     std::cout << "  Arrow Keys - Move" << std::endl;
@@ -15,6 +118,25 @@ int main() {
     // Create game instance
     Game game(800, 600);
     
+    if (seed) {
+        game.setSeed(static_cast<std::uint32_t>(std::strtoul(seed, nullptr, 10)));
+    }
+    if (hard) {
+        SearchBudget budget;
+        if (*hard) {
+            budget.microseconds = static_cast<int>(std::strtol(hard, nullptr, 10));
+        }
+        game.setEnemyAi(EnemyAi::SEARCH, budget);
+    }
+    game.setWorkerThreads(threadCount);
+    if (recordPath) {
+        game.recordTo(recordPath);
+    }
+    if (replayPath && !game.loadReplay(replayPath)) {
+        std::cerr << "Failed to load replay " << replayPath << std::endl;
+        return 1;
+    }
+    
     // Initialize game
     if (!game.initialize()) {
         std::cerr << "Failed to initialize game!" << std::endl;
@@ -28,4 +150,3 @@ int main() {
     
     return 0;
 }
-